@@ -6,16 +6,21 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <condition_variable>
 #include <cstdint>
 #include <cstddef>
+#include <deque>
 #include <filesystem>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <list>
 #include <limits>
 #include <queue>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <unordered_set>
@@ -156,7 +161,8 @@ enum class MovementSelectionType : unsigned char {
     kGreedyTrigonometric,
     kGreedyRandomBinary,
     kPathfindingAStar,
-    // kPathfindingDijkstra,
+    kPathfindingDijkstra,
+    kPathfindingAsync,
 };
 
 enum class ProjectileType : unsigned char {
@@ -342,7 +348,9 @@ namespace tile {
         std::string getProperty(std::string const& key);
         void setProperty(std::string const& key, std::string const& property);
 
+        static SDL_Surface* decode(pugi::xml_document const& XMLTilesetData);
         void load(pugi::xml_document const& XMLTilesetData, SDL_Renderer* renderer);
+        void load(pugi::xml_document const& XMLTilesetData, SDL_Surface* surface, SDL_Renderer* renderer);
         void clear();
 
         SDL_Texture* texture;
@@ -449,6 +457,7 @@ namespace tile {
         static constexpr SDL_Point kDefaultDirection = { 1, 0 };
 
         void load(pugi::xml_document const& XMLTilesetData, SDL_Renderer* renderer);
+        void load(pugi::xml_document const& XMLTilesetData, SDL_Surface* surface, SDL_Renderer* renderer);
         Data_Animation const& at(Animation animation, SDL_Point const& direction = kDefaultDirection) const;
 
         unsigned int animationTicks = 1000;
@@ -614,12 +623,6 @@ namespace event {
 
         // Uses `Generic`
         kReq_AttackRegister_Player_GHE,
-        kReq_AttackRegister_GHE_Player,
-        kReq_AttackInitiate_GHE_Player,
-        kReq_MoveInitiate_GHE_Player,
-        kResp_AttackInitiate_GHE_Player,
-        kResp_MoveInitiate_GHE_Player,
-        kResp_MoveTerminate_GHE_Player,
 
         // Uses `Interactable`
         kReq_Interact_Player_GIE,
@@ -706,6 +709,11 @@ namespace pathfinders {
         k8Directional,
     };
 
+    enum class OpenListPolicy : bool {
+        kBinaryHeap,   // Pushes duplicates and skips outdated entries upon removal, see `OpenList`
+        kIndexedHeap,   // Updates priorities in place, see `IndexedOpenList`
+    };
+
     enum class Status : unsigned char {
         kInvalidSrc,
         kInvalidDest,
@@ -764,8 +772,9 @@ namespace pathfinders {
     };
 
     struct Cell::Data {
-        Cell parent;
-        double g, h, f = std::numeric_limits<double>::max();
+        Cell parent = {};
+        double g = std::numeric_limits<double>::max(), h = 0, f = std::numeric_limits<double>::max();
+        bool isClosed = false;
     };
 
     struct Cell::Pair {
@@ -777,16 +786,10 @@ namespace pathfinders {
         inline bool operator==(Pair const& other) const { return cell == other.cell && f == other.f; }
     };
 
-    struct Result {
-        const Status status;
-        std::stack<Cell> path;
-
-        Result(Status status, std::stack<Cell> path = {}) : status(status), path(path) {}
-    };
-
     /**
      * @brief Used for the Open List in A* Search Algorithm implementation.
      * @note Supports insertion and min element removal at O(log(n)) time complexity.
+     * @note Backed by a plain `std::vector` so that `clear()` retains capacity across searches.
     */
     template <typename T, typename Compare = std::greater<T>>
     class OpenList {
@@ -797,54 +800,176 @@ namespace pathfinders {
             void push(T const&);
             T pop();
             
+            inline void push(std::size_t, T const& element) { push(element); }   // Interchangeable with `IndexedOpenList<T>`
+
+            inline T const& top() const { return getRoot(); }
             inline bool empty() const { return mHeap.empty(); }
+            inline void clear() { mHeap.clear(); }
+            inline void reset(std::size_t) { clear(); }
             
         private:
             T const& getRoot() const;
             void eraseRoot();
 
-            std::priority_queue<T, typename std::vector<T>, Compare> mHeap;
+            std::vector<T> mHeap;
+    };
+
+    /**
+     * @brief An indexed `D`-ary heap, used as an open list that holds at most one entry per cell.
+     * @note Pushing an element whose index is already present updates its priority in place ("decrease-key") instead of adding a duplicate, so no removal is ever wasted on an outdated entry.
+     * @note A wider heap is shallower, which trades a few more comparisons per removal for fewer cache misses per insertion and priority update.
+     * @see https://en.wikipedia.org/wiki/D-ary_heap
+    */
+    template <typename T, std::size_t D = 4, typename Compare = std::greater<T>>
+    class IndexedOpenList {
+        public:
+            inline IndexedOpenList() = default;
+            inline ~IndexedOpenList() = default;
+
+            void push(std::size_t index, T const& element);
+            T pop();
+
+            inline T const& top() const { return mHeap.front().second; }
+            inline bool empty() const { return mHeap.empty(); }
+            inline bool contains(std::size_t index) const { return index < mPositions.size() && mPositions[index] != kAbsent; }
+            void clear();
+            void reset(std::size_t size);
+
+        private:
+            void siftUp(std::size_t position);
+            void siftDown(std::size_t position);
+
+            static constexpr std::size_t kAbsent = std::numeric_limits<std::size_t>::max();
+
+            std::vector<std::pair<std::size_t, T>> mHeap;
+            std::vector<std::size_t> mPositions;   // Position in `mHeap` of each index, `kAbsent` if not present
+    };
+
+    template <OpenListPolicy P, typename T>
+    using OpenListOf = std::conditional_t<P == OpenListPolicy::kIndexedHeap, IndexedOpenList<T>, OpenList<T>>;
+
+    /**
+     * @brief Per-cell scratch storage of a search, kept across searches so that no allocation happens after the first one.
+     * @note `reset()` is `O(1)`: a cell whose stamp does not match the current generation is treated as untouched and lazily re-initialized on access.
+    */
+    class SearchContext {
+        public:
+            inline SearchContext() = default;
+            inline ~SearchContext() = default;
+
+            void reset(std::size_t size);
+            Cell::Data& at(std::size_t index);
+            inline bool isTouched(std::size_t index) const { return mStamps[index] == mGeneration; }
+
+        private:
+            std::vector<Cell::Data> mData;
+            std::vector<unsigned int> mStamps;
+            unsigned int mGeneration = 0;
     };
 
+    /**
+     * @brief The unit moves permitted by movement type `M`, orthogonal moves first.
+    */
+    template <MovementType M>
+    inline constexpr auto getDirections() {
+        if constexpr(M == MovementType::k4Directional) {
+            return std::array<Cell, 4>{{
+                { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+            }};
+        } else {
+            return std::array<Cell, 8>{{
+                { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+                { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 },
+            }};
+        }
+    }
+
+    /**
+     * @brief Labels the connected components of a grid, so that a search towards an unreachable cell can be rejected in constant time.
+     * @note Connectivity follows the same rules as `FlowField`. Since cells of different collision levels are never connected, components are implicitly keyed per collision level.
+     * @note Backed by a union-find structure. A cell joining a collision level merges components in near-constant time, while a cell leaving one may split its component, which is then relabelled locally.
+     * @see https://en.wikipedia.org/wiki/Connected-component_labeling
+    */
+    class Components {
+        public:
+            Components(std::vector<std::vector<int>> const& grid);
+            ~Components() = default;
+
+            void build();
+            void update(Cell const& cell);
+            void clear();
+
+            inline bool isBuilt() const { return !mParents.empty(); }
+            bool isConnected(Cell const& lhs, Cell const& rhs) const;
+
+        private:
+            bool isValid(Cell const& cell) const;
+            inline std::size_t toIndex(Cell const& cell) const { return static_cast<std::size_t>(cell.y) * mWidth + cell.x; }
+            inline Cell toCell(std::size_t index) const { return { static_cast<int>(index % mWidth), static_cast<int>(index / mWidth) }; }
+
+            std::size_t find(std::size_t index) const;
+            void unite(std::size_t lhs, std::size_t rhs);
+            void label(std::size_t root);
+
+            static constexpr std::array<Cell, 4> kDirections = {{
+                { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+            }};
+            static constexpr std::size_t kNone = std::numeric_limits<std::size_t>::max();
+
+            std::vector<std::vector<int>> const& mGrid;
+            int mWidth = 0, mHeight = 0;
+
+            mutable std::vector<std::size_t> mParents;   // Path halving happens upon lookup
+            std::vector<std::size_t> mSizes;
+            std::vector<int> mLevels;   // The collision levels as of the last `build()` or `update()`, needed to detect a cell leaving a level
+
+            std::vector<unsigned int> mStamps;
+            unsigned int mGeneration = 0;
+            std::vector<std::size_t> mQueue;
+    };
+
+    /**
+     * The shared `Components` over `level::data.collisionTilelayer`.
+     * @note Rebuilt on every call to `level::Data::load()`.
+    */
+    extern Components components;
+
     /**
      * @brief Implementation of A* pathfinding algorithm.
+     * @note Search state lives in a persistent `SearchContext` and open list, so repeated searches do not allocate.
+     * @note Diagonal moves (`k8Directional`) may not cut corners i.e. both adjacent orthogonal cells must be unblocked.
      * @see https://www.geeksforgeeks.org/a-search-algorithm/
     */
-    template <Heuristic H = Heuristic::kManhattan, MovementType M = MovementType::k4Directional>
+    template <Heuristic H = Heuristic::kManhattan, MovementType M = MovementType::k4Directional, OpenListPolicy P = OpenListPolicy::kBinaryHeap>
     class ASPF {
         public:
-            ASPF(std::vector<std::vector<int>> const& grid);
+            ASPF(std::vector<std::vector<int>> const& grid, Components const* components = nullptr);
             ~ASPF() = default;
 
             void setBegin(Cell const& begin);
             void setEnd(Cell const& end);
 
-            Result search(Cell const& src, Cell const& dest) const;
+            Status search(Cell const& src, Cell const& dest, std::vector<Cell>& path) const;
+
+            inline unsigned int getExpandedCount() const { return mExpandedCount; }   // Number of cells expanded by the last search
 
         private:
             bool isValid(Cell const& cell) const;
             bool isUnblocked(Cell const& cell) const;
             bool isUnblocked(Cell const& parent, Cell const& successor) const;
 
-            std::stack<Cell> getPath(std::vector<std::vector<Cell::Data>> const& cellData, Cell const& dest) const;
-
-            static inline constexpr auto getDirections() {
-                if constexpr(M == MovementType::k4Directional) {
-                    return std::array<Cell, 4>{{
-                        { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
-                    }};
-                } else {
-                    return std::array<Cell, 8>{{
-                        { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
-                        { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 },
-                    }};
-                }
-            }
+            inline std::size_t toIndex(Cell const& cell) const { return static_cast<std::size_t>(cell.y) * mGrid.front().size() + cell.x; }
+            void getPath(Cell const& dest, std::vector<Cell>& path) const;
 
             std::vector<std::vector<int>> const& mGrid;
+            Components const* mComponents;   // Optional, allows rejecting unreachable destinations in constant time
             Cell mBegin, mEnd;
 
-            static inline constexpr auto mDirections = getDirections();
+            mutable SearchContext mContext;
+            mutable OpenListOf<P, Cell::Pair> mOpenList;
+            mutable unsigned int mExpandedCount = 0;
+
+            static inline constexpr auto mDirections = getDirections<M>();
     };
 
     /**
@@ -861,6 +986,403 @@ namespace pathfinders {
     */
     template <MovementType M = MovementType::k4Directional>
     using GBFSPF = ASPF<Heuristic::kContantInf, M>;
+
+    /**
+     * @brief Implementation of Jump Point Search, an A* variant for uniform-cost grids that expands only "jump points" i.e. cells with forced neighbours, skipping over symmetric paths.
+     * @note Yields the same path cost as `ASPF<H, M>`, under the same connectivity rules. The returned path lists every cell, not only jump points.
+     * @see https://harablog.wordpress.com/2011/09/07/jump-point-search/
+     * @see https://github.com/qiao/PathFinding.js/tree/master/src/finders
+    */
+    template <Heuristic H = Heuristic::kOctile, MovementType M = MovementType::k8Directional, OpenListPolicy P = OpenListPolicy::kBinaryHeap>
+    class JPSPF {
+        public:
+            JPSPF(std::vector<std::vector<int>> const& grid, Components const* components = nullptr);
+            ~JPSPF() = default;
+
+            void setBegin(Cell const& begin);
+            void setEnd(Cell const& end);
+
+            Status search(Cell const& src, Cell const& dest, std::vector<Cell>& path) const;
+
+            inline unsigned int getExpandedCount() const { return mExpandedCount; }
+
+        private:
+            bool isValid(Cell const& cell) const;
+            bool isWalkable(Cell const& cell) const;
+            bool isUnblocked(Cell const& parent, Cell const& successor) const;
+
+            std::optional<Cell> jump(Cell cell, Cell const& direction) const;
+
+            template <typename Callable>
+            void forEachNeighbour(Cell const& cell, Cell const& parent, Callable&& callable) const;
+
+            inline std::size_t toIndex(Cell const& cell) const { return static_cast<std::size_t>(cell.y) * mGrid.front().size() + cell.x; }
+            void getPath(Cell const& dest, std::vector<Cell>& path) const;
+
+            std::vector<std::vector<int>> const& mGrid;
+            Components const* mComponents;
+            Cell mBegin, mEnd;
+
+            mutable int mLevel;   // The collision level of the current search
+            mutable Cell mDest;
+
+            mutable SearchContext mContext;
+            mutable OpenListOf<P, Cell::Pair> mOpenList;
+            mutable unsigned int mExpandedCount = 0;
+
+            static inline constexpr auto mDirections = getDirections<M>();
+    };
+
+    /**
+     * @brief Implementation of JPS+, which precomputes for every cell and direction the distance to the next jump point (positive) or wall (non-positive), so that a search never scans the grid.
+     * @note Searches are bounded by the destination: a jump stops early upon reaching the row or column of `dest`.
+     * @note Spans the whole grid, hence no `setBegin()`/`setEnd()`. `precompute()` must be called whenever the grid changes.
+     * @note Defined for 8-directional movement only.
+     * @see Steve Rabin, "JPS+: An Extreme A* Speed Optimization for Static Uniform Cost Grids", Game AI Pro 2, Chapter 14.
+    */
+    template <Heuristic H = Heuristic::kOctile, MovementType M = MovementType::k8Directional, OpenListPolicy P = OpenListPolicy::kBinaryHeap>
+    class JPSPlusPF {
+        static_assert(M == MovementType::k8Directional, "JPS+ is defined for 8-directional movement only");
+
+        public:
+            JPSPlusPF(std::vector<std::vector<int>> const& grid, Components const* components = nullptr);
+            ~JPSPlusPF() = default;
+
+            void precompute();
+            Status search(Cell const& src, Cell const& dest, std::vector<Cell>& path) const;
+
+            inline unsigned int getExpandedCount() const { return mExpandedCount; }
+
+        private:
+            bool isValid(Cell const& cell) const;
+            bool isWalkable(Cell const& cell, int level) const;
+            bool isJumpPoint(Cell const& cell, Cell const& direction) const;
+
+            inline std::size_t toIndex(Cell const& cell) const { return static_cast<std::size_t>(cell.y) * mWidth + cell.x; }
+            void getPath(Cell const& dest, std::vector<Cell>& path) const;
+
+            std::vector<std::vector<int>> const& mGrid;
+            Components const* mComponents;
+            int mWidth = 0, mHeight = 0;
+
+            /**
+             * Indexed as `mDistances[toIndex(cell)][i]` where `i` is the index of the direction in `mDirections`.
+            */
+            std::vector<std::array<int, 8>> mDistances;
+
+            mutable SearchContext mContext;
+            mutable OpenListOf<P, Cell::Pair> mOpenList;
+            mutable unsigned int mExpandedCount = 0;
+
+            static inline constexpr auto mDirections = getDirections<M>();
+    };
+
+    /**
+     * @brief A distance field (also known as "Dijkstra map") over a uniform-cost, 4-directional grid, rooted at a goal.
+     * @note Two cells are connected if they are adjacent and share the same non-zero collision level, mirroring `AbstractAnimatedDynamicEntity<T>::validateMove()`.
+     * @note Lookups, including `getNextCell()`, are `O(1)`. Moving the goal to an adjacent cell is repaired in place instead of rebuilt, see `update()`.
+     * @see https://www.roguebasin.com/index.php/The_Incredible_Power_of_Dijkstra_Maps
+    */
+    class FlowField {
+        public:
+            FlowField(std::vector<std::vector<int>> const& grid);
+            ~FlowField() = default;
+
+            void build(Cell const& goal);
+            void update(Cell const& goal);
+            void clear();
+
+            inline bool isBuilt() const { return mIsBuilt; }
+            inline Cell const& getGoal() const { return mGoal; }
+
+            unsigned int getDistance(Cell const& cell) const;
+            std::optional<Cell> getNextCell(Cell const& cell) const;
+
+            static constexpr unsigned int kUnreachable = std::numeric_limits<unsigned int>::max();
+
+        private:
+            bool isValid(Cell const& cell) const;
+            bool isUnblocked(Cell const& parent, Cell const& successor) const;
+            inline std::size_t toIndex(Cell const& cell) const { return static_cast<std::size_t>(cell.y) * mWidth + cell.x; }
+
+            static constexpr std::array<Cell, 4> kDirections = {{
+                { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+            }};
+            static constexpr int kUnreachableValue = std::numeric_limits<int>::max();
+
+            std::vector<std::vector<int>> const& mGrid;
+            int mWidth = 0, mHeight = 0;
+            Cell mGoal;
+            bool mIsBuilt = false;
+
+            /**
+             * The distance of a cell is its stored value plus `mOffset`, which allows `update()` to shift every distance at once.
+            */
+            std::vector<int> mValues;
+            int mOffset = 0;
+
+            std::vector<std::size_t> mQueue;   // Reused across builds to avoid reallocation
+    };
+
+    /**
+     * @brief A fixed-size pool of `FlowField`, keyed by goal and recycled in least-recently-used order.
+     * @note Every entity chasing the same goal shares a single field, so the cost is one field build (or repair) per goal change instead of one search per entity.
+    */
+    class FlowFieldCache {
+        public:
+            FlowFieldCache(std::vector<std::vector<int>> const& grid, std::size_t size);
+            ~FlowFieldCache() = default;
+
+            FlowField const& get(Cell const& goal);
+            void clear();
+
+        private:
+            std::vector<FlowField> mFields;
+            std::vector<unsigned long long int> mLastUsed;
+            unsigned long long int mClock = 0;
+    };
+
+    /**
+     * The shared `FlowFieldCache` over `level::data.collisionTilelayer`.
+     * @note Cleared on every call to `level::Data::load()`.
+    */
+    extern FlowFieldCache flowfields;
+
+    /**
+     * @brief Implementation of Hierarchical Pathfinding A* (HPA*) over a uniform-cost, 4-directional grid.
+     * @note The grid is partitioned into square clusters. Entrances along shared cluster borders become the nodes of an abstract graph, whose intra-cluster edge costs are precomputed by `build()`.
+     * @note `search()` only yields the abstract path i.e. the waypoints. Consecutive waypoints always share a cluster or are adjacent, so `refine()` can expand them one cluster at a time, on demand.
+     * @note Connectivity follows the same rules as `FlowField`. Paths are optimal within clusters but not necessarily across them, as is inherent to HPA*.
+     * @see https://webdocs.cs.ualberta.ca/~mmueller/ps/hpastar.pdf
+    */
+    class HPAPF {
+        public:
+            HPAPF(std::vector<std::vector<int>> const& grid, int clusterSize, Components const* components = nullptr);
+            ~HPAPF() = default;
+
+            void build();
+            void update(Cell const& cell);
+            void clear();
+
+            inline bool isBuilt() const { return !mClusters.empty(); }
+
+            Status search(Cell const& src, Cell const& dest, std::vector<Cell>& waypoints) const;
+            Status refine(Cell const& src, Cell const& dest, std::vector<Cell>& path) const;
+
+            inline unsigned int getExpandedCount() const { return mExpandedCount; }   // Number of abstract nodes expanded by the last search
+
+            static constexpr unsigned int kUnreachable = std::numeric_limits<unsigned int>::max();
+
+        private:
+            /**
+             * Entrance cells of a cluster, with the pairwise in-cluster distances in row-major order.
+            */
+            struct Cluster {
+                std::vector<Cell> nodes;
+                std::vector<unsigned int> costs;
+            };
+
+            bool isValid(Cell const& cell) const;
+            bool isUnblocked(Cell const& parent, Cell const& successor) const;
+
+            inline std::size_t toIndex(Cell const& cell) const { return static_cast<std::size_t>(cell.y) * mWidth + cell.x; }
+            inline std::size_t toClusterIndex(Cell const& cell) const { return static_cast<std::size_t>(cell.y / mClusterSize) * mClusterCount.x + cell.x / mClusterSize; }
+            inline Cell getClusterOrigin(std::size_t index) const { return { static_cast<int>(index % mClusterCount.x) * mClusterSize, static_cast<int>(index / mClusterCount.x) * mClusterSize }; }
+            bool isWithinCluster(Cell const& cell, std::size_t index) const;
+
+            void addBorders(std::size_t index);
+            void addEntrances(Cell const& begin, Cell const& end, Cell const& across);
+            void addNode(Cell const& cell);
+            void connect(std::size_t index);
+
+            void flood(Cell const& src) const;
+            inline unsigned int getFloodDistance(Cell const& cell) const { return mFloodDistances[toLocalIndex(cell)]; }
+            inline std::size_t toLocalIndex(Cell const& cell) const { return static_cast<std::size_t>(cell.y % mClusterSize) * mClusterSize + cell.x % mClusterSize; }
+
+            static constexpr std::array<Cell, 4> kDirections = {{
+                { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+            }};
+            static constexpr int kMaxEntranceWidth = 6;   // Longer entrances are represented by both of their ends instead of their middle
+
+            std::vector<std::vector<int>> const& mGrid;
+            Components const* mComponents;
+            int mClusterSize;
+            int mWidth = 0, mHeight = 0;
+            Cell mClusterCount = { 0, 0 };
+
+            std::vector<Cluster> mClusters;
+            std::vector<int> mNodeIndices;   // Index of each cell in the `nodes` of its cluster, `-1` if it is not an entrance
+
+            mutable SearchContext mContext;
+            mutable OpenList<Cell::Pair> mOpenList;
+            mutable unsigned int mExpandedCount = 0;
+
+            // Scratch storage of the in-cluster breadth-first search, sized to a single cluster
+            mutable std::vector<unsigned int> mFloodDistances;
+            mutable std::vector<int> mFloodParents;
+            mutable std::vector<Cell> mFloodQueue;
+            mutable std::size_t mFloodCluster = 0;
+
+            mutable std::vector<unsigned int> mSrcCosts, mDestCosts;
+    };
+
+    /**
+     * @brief Implementation of D* Lite, an incremental variant of A* over a uniform-cost, 4-directional grid that keeps its search state across queries.
+     * @note Searches backward from `dest`. Moving `src` only shifts priorities, while moving `dest` or changing cells only repairs the cells whose distance is affected.
+     * @note Connectivity follows the same rules as `FlowField`, further restricted by cells marked via `setBlocked()`.
+     * @see http://idm-lab.org/bib/abstracts/papers/aaai02b.pdf
+    */
+    class DSLPF {
+        public:
+            DSLPF(std::vector<std::vector<int>> const& grid, Components const* components = nullptr);
+            ~DSLPF() = default;
+
+            void setBegin(Cell const& begin);
+            void setEnd(Cell const& end);
+
+            Status search(Cell const& src, Cell const& dest, std::vector<Cell>& path);
+
+            void update(Cell const& cell);
+            void setBlocked(Cell const& cell, bool isBlocked);
+            void clear();
+
+            inline unsigned int getExpandedCount() const { return mExpandedCount; }   // Number of cells expanded by the last search
+            inline unsigned int getReexpandedCount() const { return mReexpandedCount; }   // Number of expanded cells whose distance had been settled by a previous search
+            inline unsigned int getReusedCount() const { return mReusedCount; }   // Number of cells whose distance carried over from previous searches untouched
+
+        private:
+            using Key = std::pair<int, int>;
+
+            struct Node {
+                int g, rhs;
+                Key key;
+                bool isOpen = false;
+                unsigned int stamp = 0;   // The last search that expanded this cell
+            };
+
+            struct Entry {
+                Key key;
+                Cell cell;
+
+                inline bool operator>(Entry const& other) const { return key > other.key; }
+            };
+
+            bool isValid(Cell const& cell) const;
+            bool isUnblocked(Cell const& parent, Cell const& successor) const;
+            inline std::size_t toIndex(Cell const& cell) const { return static_cast<std::size_t>(cell.y) * mWidth + cell.x; }
+            inline std::size_t toNodeIndex(Cell const& cell) const { return static_cast<std::size_t>(cell.y - mNodeOrigin.y) * mNodeWidth + (cell.x - mNodeOrigin.x); }
+
+            void fit();
+            void initialize(Cell const& src, Cell const& dest);
+            Key calculateKey(Cell const& cell) const;
+            int calculateRhs(Cell const& cell) const;
+            void setG(Node& node, int g);
+            void updateVertex(Cell const& cell);
+            Key getTopKey();
+            void computeShortestPath();
+
+            static constexpr std::array<Cell, 4> kDirections = {{
+                { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+            }};
+            static constexpr int kInfinity = std::numeric_limits<int>::max() / 4;
+
+            std::vector<std::vector<int>> const& mGrid;
+            Components const* mComponents;
+            int mWidth = 0, mHeight = 0;
+            bool mIsInitialized = false;
+
+            Cell mBegin = { 0, 0 }, mEnd = { kInfinity, kInfinity };   // Search window, inclusive
+            Cell mNodeOrigin = { 0, 0 };
+            int mNodeWidth = 0;
+
+            Cell mSrc, mDest;
+            int mModifier = 0;   // Accumulated heuristic shift since `initialize()`, also known as `km`
+
+            std::vector<Node> mNodes;
+            std::vector<bool> mBlocked;
+            OpenList<Entry> mOpenList;
+
+            unsigned int mSearchCount = 0;
+            unsigned int mSettledCount = 0;   // Number of cells with a finite distance
+            unsigned int mExpandedCount = 0, mReexpandedCount = 0, mReusedCount = 0;
+    };
+
+    /**
+     * The shared `HPAPF` over `level::data.collisionTilelayer`.
+     * @note Rebuilt on every call to `level::Data::load()`.
+    */
+    extern HPAPF hierarchy;
+
+    /**
+     * @brief A queue of path requests served by `JPSPF`/`JPSPlusPF` searches on worker threads, so that no search runs inside a frame.
+     * @note Searches read an immutable snapshot of the grid taken by `synchronize()`, never the grid itself.
+     * @note Results are published only by `collect()`, which should be called at a fixed point in the frame. Every method should be called from the main thread.
+    */
+    class PathService {
+        public:
+            using Ticket = unsigned long long int;
+
+            struct Request {
+                Cell src, dest;
+                MovementType movementType = MovementType::k4Directional;
+            };
+
+            struct Result {
+                Status status = Status::kFailure;
+                std::vector<Cell> path;   // In reverse order, see `ASPF<H, M>::search()`
+            };
+
+            PathService(std::vector<std::vector<int>> const& grid, std::size_t workerCount, Components const* components = nullptr);
+            ~PathService();
+
+            void synchronize();
+
+            Ticket submit(Request const& request);
+            void cancel(Ticket ticket);
+
+            void collect();
+            std::optional<Result> retrieve(Ticket ticket);
+
+            static constexpr Ticket kInvalidTicket = 0;
+
+        private:
+            using Grid = std::vector<std::vector<int>>;
+
+            struct Job {
+                Ticket ticket;
+                Request request;
+                std::shared_ptr<const Grid> grid;
+            };
+
+            void work();
+
+            Grid const& mGrid;
+            Components const* mComponents;
+            std::size_t mWorkerCount;
+            std::vector<std::thread> mWorkers;
+
+            std::shared_ptr<const Grid> mSnapshot;
+            Ticket mNextTicket = kInvalidTicket + 1;
+            Ticket mFirstValidTicket = kInvalidTicket + 1;   // Tickets issued before the latest `synchronize()` are discarded
+
+            // Shared with workers, guarded by `mMutex`
+            std::mutex mMutex;
+            std::condition_variable mCondition;
+            std::deque<Job> mPending;
+            std::vector<std::pair<Ticket, Result>> mCompleted;
+            std::unordered_set<Ticket> mCancelled;
+            bool mIsStopping = false;
+
+            std::unordered_map<Ticket, Result> mResults;   // Published, not yet retrieved
+    };
+
+    /**
+     * The shared `PathService` over `level::data.collisionTilelayer`.
+     * @note Re-synchronized on every call to `level::Data::load()`.
+    */
+    extern PathService service;
+
+    void benchmark();
 };
 
 
@@ -871,7 +1393,15 @@ namespace pathfinders {
 */
 namespace config {
     constexpr bool enable_audio = true;
+    constexpr bool enable_startup_report = false;   // Log startup phases via `SDL_Log()` once every asset is loaded
+    constexpr bool enable_frame_report = false;   // Log rendering figures of the latest frame via `SDL_Log()` whenever the FPS overlay updates
     constexpr bool enable_entity_overlap = true;
+    constexpr bool enable_save_json_export = false;   // Also write the save as JSON next to it, for debugging
+#if defined(NDEBUG)
+    constexpr bool enable_loose_assets = false;
+#else
+    constexpr bool enable_loose_assets = true;   // Loose files override archived ones, at the cost of a `stat()` per asset. Debug builds only
+#endif
 
     /**
      * Uses `operator~` for static conversion to `SDL_Keycode`.
@@ -910,6 +1440,7 @@ namespace config {
         const std::filesystem::path asset_tiled = asset / ".tiled";
         const std::filesystem::path asset_font = asset / "fonts";
         const std::filesystem::path asset_audio = asset / "audio";
+        const std::filesystem::path archive = "assets.pak";   // Packed from `asset` by `--pack`
         
         namespace font {
             const std::filesystem::path OmoriChaotic = asset_font / "omori-game-1.ttf";
@@ -954,6 +1485,13 @@ namespace config {
 
     namespace game {
         constexpr int FPS = 60;
+        constexpr int TPS = 60;   // Simulation ticks per second. Per-tick constants e.g. `sVelocity` were tuned at 60
+        constexpr int maxTicksPerFrame = 5;   // Catch-up limit; the simulation slows down instead of spiralling when frames take longer
+        constexpr bool isVSyncAware = true;   // Leave pacing to `SDL_RenderPresent()` if the renderer presents with VSync
+        constexpr std::size_t frameHistorySize = 120;
+        constexpr double windowChangeSettleMilliseconds = 150;   // Resizing is applied once no further resize event has arrived for this long
+        constexpr std::size_t maxAssetLoaderWorkerCount = 4;
+        constexpr double assetFinalizeBudgetMilliseconds = 2;   // Per frame, spent creating textures of assets decoded in the background
         const std::filesystem::path windowIconPath = config::path::asset / "icon/light.png";
 
         const std::tuple<GameInitFlag, SDL_Rect, int, std::string> initializer = {
@@ -984,10 +1522,14 @@ namespace config {
         constexpr int masterVolume = 66;
         constexpr int BGM_Volume = 25;
         constexpr int SFX_Volume = 50;
+
+        constexpr int SFXVoiceCount = 16;   // Mixing channels i.e. the most SFX audible at once
+        constexpr double SFXAudibleDistance = 16;   // In tiles, from the player
+        constexpr std::size_t BGMCacheBudget = 16 << 20;   // In bytes of encoded audio i.e. a handful of tracks
     }
 
     namespace interface {
-        const std::filesystem::path savePath = "build/save/autosave.json";
+        const std::filesystem::path savePath = "build/save/autosave.sav";
         const std::filesystem::path levelPath = "assets/.tiled/levels.json";
         constexpr level::Name levelName = level::Name::kLevelPrelude;
         constexpr int idleFrames = 16;
@@ -1003,8 +1545,13 @@ namespace config {
     namespace entities {
         constexpr double runVelocityModifier = 4;
         constexpr SDL_FRect destRectModifier = { 0, 0, 1, 1 };
-        constexpr unsigned int SFXTicks = 777;
-        constexpr unsigned int ASPFTicks = 1111;
+        constexpr unsigned int ASPFTicks = 1111;   // Minimum interval between two replans of a `kPathfindingAStar` hostile
+        constexpr std::size_t FlowFieldCacheSize = 4;
+        constexpr int HPAClusterSize = 10;
+        constexpr std::size_t AutopilotFlowFieldMaxCells = 4096;   // Larger levels route the autopilot over `pathfinders::hierarchy`, so that toggling it never floods the whole level at once
+        constexpr std::size_t PathServiceWorkerCount = 2;
+        constexpr int CullingBucketSize = 8;   // In tiles
+        constexpr int CullingMargin = 2;   // In tiles, around the visible portion of the level
         
         namespace player {
             constexpr const char* typeID = "player";
@@ -1238,6 +1785,19 @@ namespace config {
     namespace components {
         constexpr SDL_Point destRectRatio = { 10, 2 };
 
+        namespace ui_compositor {
+            constexpr std::size_t maxDirtyRectCount = 8;   // Beyond which dirty rects are merged into their bounding rect
+        }
+
+        namespace glyph_atlas {
+            constexpr SDL_Point initialSize = { 256, 256 };
+            constexpr int maxSize = 4096;   // Per dimension, most renderers support at least this much
+        }
+
+        namespace font_service {
+            constexpr std::size_t retainedAtlasCount = 8;   // Unreferenced atlases kept around e.g. for the previous window size
+        }
+
         namespace fps_overlay {
             const std::tuple<SDL_FPoint, ComponentPreset, std::string> initializer = std::make_tuple(SDL_FPoint{ 0.1f, 0.1f }, config::preset::FPSOverlay, "");
             constexpr double destSizeModifier = 0.25;
@@ -1265,6 +1825,9 @@ namespace config {
             constexpr double destOffsetRatio = 0.1;
             const std::filesystem::path fontPath = config::path::font::OmoriHarmonic;
             constexpr unsigned short int delayCounterLimit = config::game::FPS >> 2;
+            constexpr int atlasPageSize = 512;
+            constexpr std::size_t atlasMaxPageCount = 8;
+            constexpr std::size_t retainedFontCount = 2;   // Including the one in use
 
             const std::vector<std::string> test = {
                 "Steady your heartbeat....\nDon't be afraid. It's not as scary as you think.",
@@ -1350,6 +1913,164 @@ namespace config {
 }
 
 
+/**
+ * @brief Collect textured quads and submit them in as few `SDL_RenderGeometry()` calls as possible, instead of one `SDL_RenderCopy()` each.
+ * @note Quads are stably sorted by layer, then by texture within layers given explicitly i.e. quads in such a layer are assumed not to overlap e.g. tiles of one tilelayer. Quads drawn with `kOrderedLayer` keep their submission order, merging only consecutive quads that share a texture.
+ * @note Recommended implementation: call `flush()` before the render target changes, and before anything is rendered directly.
+*/
+class SpriteBatcher {
+    public:
+        struct Stats {
+            std::size_t sprites = 0;   // Quads submitted i.e. former draw calls
+            std::size_t batches = 0;   // `SDL_RenderGeometry()` calls
+        };
+
+        static constexpr int kOrderedLayer = -1;
+
+        SpriteBatcher() = default;
+        ~SpriteBatcher() = default;
+
+        void draw(SDL_Texture* texture, SDL_Rect const& srcRect, SDL_Rect const& destRect, SDL_RendererFlip flip = SDL_FLIP_NONE, double angle = 0, SDL_Point const* center = nullptr, SDL_Color color = { 0xff, 0xff, 0xff, 0xff }, int layer = kOrderedLayer);
+        void flush(SDL_Renderer* renderer);
+        void clear();
+
+        void setTransform(SDL_FPoint const& offset, SDL_FPoint const& scale);
+        void resetTransform();
+        SDL_Rect transform(SDL_Rect const& rect) const;
+
+        inline void resetStats() { mStats = Stats{}; }
+        inline Stats const& getStats() const { return mStats; }
+
+    private:
+        struct Quad {
+            SDL_Texture* texture;
+            SDL_FRect srcRect;   // Normalized lazily i.e. in pixels until `flush()`
+            std::array<SDL_FPoint, 4> corners;   // Top-left, top-right, bottom-right, bottom-left, after rotation
+            SDL_RendererFlip flip;
+            SDL_Color color;
+            int layer;
+            std::size_t order;   // Run index for `kOrderedLayer`, ignored otherwise
+        };
+
+        std::vector<Quad> mQuads;
+        std::vector<std::size_t> mSortedIndices;
+        std::vector<SDL_Vertex> mVertices;
+        std::vector<int> mIndices;
+
+        /**
+         * Applied to quads as they are drawn e.g. world-to-camera, then rounded to whole pixels so that adjacent quads stay seamless.
+        */
+        SDL_FPoint mOffset = { 0, 0 };
+        SDL_FPoint mScale = { 1, 1 };
+
+        std::size_t mRunCount = 0;
+        Stats mStats;
+};
+
+
+/**
+ * @brief Serve assets from a single memory-mapped archive, so that loading an asset costs no syscall.
+ * @note Layout: a header, the entries' data, then an index of fixed-size records sorted by path, followed by the paths themselves. Each entry is stored either as is, or deflated with zlib if that makes it smaller.
+ * @note Paths are relative to the working directory e.g. "assets/icon/light.png". Loose files override archived ones if `config::enable_loose_assets`.
+ * @note Read-only once mounted, hence safe to read from any thread.
+*/
+class AssetArchive {
+    public:
+        enum class Compression : Uint8 {
+            kNone,
+            kZlib,
+        };
+
+        AssetArchive() = default;
+        ~AssetArchive();
+        AssetArchive(AssetArchive const&) = delete;
+        AssetArchive& operator=(AssetArchive const&) = delete;
+
+        bool mount(std::filesystem::path const& archivePath);
+        void unmount();
+
+        bool exists(std::filesystem::path const& path) const;
+        bool isMapped(std::filesystem::path const& path) const;
+        std::optional<std::size_t> getSize(std::filesystem::path const& path) const;
+        SDL_RWops* open(std::filesystem::path const& path) const;
+        bool read(std::filesystem::path const& path, std::vector<char>& data) const;
+
+        static bool pack(std::filesystem::path const& directory, std::filesystem::path const& archivePath);
+
+    private:
+        struct Header {
+            std::array<char, 4> magic;
+            Uint32 version;
+            Uint64 entryCount;
+            Uint64 indexOffset;
+        };
+
+        struct Record {
+            Uint64 offset;
+            Uint64 storedSize;
+            Uint64 size;   // Once inflated
+            Uint32 pathOffset;   // Relative to the end of the records
+            Uint16 pathSize;
+            Compression compression;
+            Uint8 reserved;
+        };
+
+        struct Entry {
+            std::string_view path;   // Within the mapping
+            Record record;
+        };
+
+        static constexpr std::array<char, 4> kMagic = { 'I', 'N', 'T', 'R' };
+        static constexpr Uint32 kVersion = 1;
+
+        static std::string getKey(std::filesystem::path const& path);
+        Entry const* find(std::filesystem::path const& path) const;
+        Entry const* resolve(std::filesystem::path const& path) const;
+        bool inflate(Entry const& entry, void* dest) const;
+
+        unsigned char const* mBase = nullptr;
+        std::size_t mSize = 0;
+        std::vector<Entry> mEntries;   // Sorted by `path`
+};
+
+
+/**
+ * @brief Encode and write files on a worker thread, so that neither stalls a frame.
+ * @note Writes are atomic: data is written to a temporary file, flushed to disk, then renamed over the destination, which therefore holds either the previous or the new contents, even if the game crashes midway.
+ * @note A submission replaces one for the same path that has yet to start. Every method should be called from the main thread.
+*/
+class FileWriter {
+    public:
+        FileWriter() = default;
+        ~FileWriter();
+        FileWriter(FileWriter const&) = delete;
+        FileWriter& operator=(FileWriter const&) = delete;
+
+        void submit(std::filesystem::path const& path, std::function<std::string(void)> const& encode);
+        void flush();
+
+        static bool commit(std::filesystem::path const& path, std::string const& data);
+
+    private:
+        struct Job {
+            std::filesystem::path path;
+            std::function<std::string(void)> encode;   // Runs on the worker, hence should only read what it captures
+        };
+
+        void work();
+
+        std::thread mWorker;
+
+        // Shared with the worker, guarded by `mMutex`
+        std::mutex mMutex;
+        std::condition_variable mPendingCondition;
+        std::condition_variable mIdleCondition;
+        std::deque<Job> mPending;
+        bool mIsWriting = false;
+        bool mIsStopping = false;
+};
+
+
 /**
  * @brief Group components that are accessible at public scope to all other components.
 */
@@ -1377,6 +2098,16 @@ namespace globals {
     extern GameState state;
 
     extern GarbageCollector gc;
+
+    /**
+     * The global `SpriteBatcher`, used by entities and the map.
+    */
+    extern SpriteBatcher batcher;
+
+    /**
+     * The global `AssetArchive`, mounted during `<game.h> Game::initialize()` before any asset is loaded.
+    */
+    extern AssetArchive archive;
 }
 
 
@@ -1471,6 +2202,7 @@ namespace utils {
     std::string dtos(const double d, unsigned int precision);
     SDL_Point fpttopt(SDL_FPoint const& fpt);
     SDL_Color hextocol(std::string const& hexString);
+    Uint32 nextCodepoint(std::string_view s, std::size_t& i);
     
     int generateRandomBinary(const double probability = 0.5);
     void setRendererDrawColor(SDL_Renderer* renderer, SDL_Color const& color);
@@ -1485,6 +2217,7 @@ namespace utils {
     std::string base64Decode(std::string const& s);
 
     void fetch(std::filesystem::path const& path, json& data);
+    pugi::xml_parse_result fetch(std::filesystem::path const& path, pugi::xml_document& document);
     std::filesystem::path cleanRelativePath(std::filesystem::path const& path);
 }
 
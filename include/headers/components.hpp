@@ -7,7 +7,9 @@
 #include <map>
 #include <unordered_map>
 #include <type_traits>
+#include <deque>
 #include <queue>
+#include <vector>
 
 #include <SDL.h>
 #include <SDL_ttf.h>
@@ -16,6 +18,80 @@
 #include <auxiliaries.hpp>
 
 
+/**
+ * @brief Rasterize the glyphs of one font, at one size and style, once each into a shared texture, and lay out text as quads sampling from it.
+ * @note Glyphs are rendered white, and are expected to be tinted through vertex colors e.g. via `SpriteBatcher::draw()`.
+ * @note The texture grows on demand, and may thus be replaced; source rects of glyphs remain valid regardless.
+*/
+class GlyphAtlas {
+    public:
+        struct Glyph {
+            SDL_Rect srcRect;
+            int minX;   // Horizontal offset of the glyph's left edge from the pen position
+            int advance;
+        };
+
+        /**
+         * A glyph positioned relative to the top-left corner of laid-out text.
+        */
+        struct Quad {
+            SDL_Rect srcRect;
+            SDL_Rect destRect;
+        };
+
+        GlyphAtlas(TTF_Font* font);
+        ~GlyphAtlas();
+
+        SDL_Point layout(std::string const& content, std::vector<Quad>& quads);
+        inline SDL_Texture* getTexture() const { return mTexture; }
+        inline TTF_Font* getFont() const { return mFont; }
+
+    private:
+        Glyph const* getGlyph(Uint32 codepoint);
+        bool pack(SDL_Point const& size, SDL_Point& origin);
+        bool grow(SDL_Point const& minSize);
+
+        static constexpr int kPadding = 1;   // Prevent bleeding between neighbouring glyphs when sampled with filtering
+
+        TTF_Font* mFont;
+        SDL_Texture* mTexture = nullptr;
+        SDL_Point mTextureSize = { 0, 0 };
+
+        SDL_Point mShelfOrigin = { 0, 0 };
+        int mShelfHeight = 0;
+
+        std::unordered_map<Uint32, std::optional<Glyph>> mGlyphs;   // `std::nullopt` for glyphs the font does not provide
+};
+
+
+/**
+ * @brief Share one `GlyphAtlas` per font, size and style between all text components, reference-counted.
+ * @note Unreferenced atlases are retained, least-recently-released first out, so that switching back to a recent window size reuses them.
+*/
+class FontService final : public Singleton<FontService> {
+    public:
+        INCL_SINGLETON(FontService)
+
+        FontService() = default;
+        ~FontService() = default;
+
+        GlyphAtlas* acquire(std::filesystem::path const& path, int size, int style = TTF_STYLE_NORMAL);
+        void release(GlyphAtlas* atlas);
+
+    private:
+        struct Entry {
+            std::unique_ptr<GlyphAtlas> atlas;
+            std::size_t referenceCount = 0;
+            unsigned long long lastReleased = 0;
+        };
+
+        void evictUnreferenced();
+
+        std::map<std::tuple<std::string, int, int>, Entry> mAtlases;
+        unsigned long long mReleaseCount = 0;
+};
+
+
 /* Abstract templates */
 
 /**
@@ -34,6 +110,8 @@ class GenericComponent : public Multiton<T> {
     protected:
         GenericComponent(SDL_FPoint const& center, ComponentPreset const& preset);
 
+        void invalidate(SDL_Rect const& rect) const;
+
         static int sDestSize;
         static const double kDestSizeModifier;
         static const SDL_Point kDestRectRatio;
@@ -54,7 +132,7 @@ namespace std {
     };
 }
 
-#define INCL_GENERIC_COMPONENT(T) using GenericComponent<T>::onWindowChange, GenericComponent<T>::sDestSize, GenericComponent<T>::kDestSizeModifier, GenericComponent<T>::kDestRectRatio, GenericComponent<T>::kCenter, GenericComponent<T>::kPreset;
+#define INCL_GENERIC_COMPONENT(T) using GenericComponent<T>::onWindowChange, GenericComponent<T>::invalidate, GenericComponent<T>::sDestSize, GenericComponent<T>::kDestSizeModifier, GenericComponent<T>::kDestRectRatio, GenericComponent<T>::kCenter, GenericComponent<T>::kPreset;
 
 
 template <typename T>
@@ -75,7 +153,7 @@ class GenericBoxComponent : virtual public GenericComponent<T> {
         void loadBoxTexture(SDL_Texture*& texture, ComponentPreset const& preset);
 
         SDL_Texture* mBoxTexture = nullptr;
-        SDL_Rect mBoxDestRect;
+        SDL_Rect mBoxDestRect = {};
 };
 
 #define INCL_GENERIC_BOX_COMPONENT(T) using GenericBoxComponent<T>::render, GenericBoxComponent<T>::onWindowChange, GenericBoxComponent<T>::shrinkRect, GenericBoxComponent<T>::loadBoxTexture, GenericBoxComponent<T>::mBoxTexture, GenericBoxComponent<T>::mBoxDestRect;
@@ -87,7 +165,7 @@ class GenericTextComponent : virtual public GenericComponent<T> {
         INCL_MULTITON(T)
         INCL_GENERIC_COMPONENT(T)
 
-        virtual ~GenericTextComponent();
+        virtual ~GenericTextComponent() = default;
 
         static void deinitialize();
 
@@ -99,18 +177,20 @@ class GenericTextComponent : virtual public GenericComponent<T> {
     protected:  
         GenericTextComponent(SDL_FPoint const& center, ComponentPreset const& preset, std::string const& content);
 
-        void loadTextTexture(SDL_Texture*& texture, ComponentPreset const& preset);
+        void layoutText();
+        void renderText(SDL_Color const& color) const;
+        static void releaseGlyphAtlas();
 
-        static TTF_Font* sFont;
+        static GlyphAtlas* sGlyphAtlas;
         static const std::filesystem::path sFontPath;
 
-        SDL_Texture* mTextTexture = nullptr;
-        SDL_Rect mTextDestRect;
+        std::vector<GlyphAtlas::Quad> mTextQuads;
+        SDL_Rect mTextDestRect = {};
 
         std::string mContent;
 };
 
-#define INCL_GENERIC_TEXT_COMPONENT(T) using GenericTextComponent<T>::deinitialize, GenericTextComponent<T>::render, GenericTextComponent<T>::onWindowChange, GenericTextComponent<T>::editContent, GenericTextComponent<T>::loadTextTexture, GenericTextComponent<T>::sFont, GenericTextComponent<T>::sFontPath, GenericTextComponent<T>::mTextTexture, GenericTextComponent<T>::mTextDestRect, GenericTextComponent<T>::mContent;
+#define INCL_GENERIC_TEXT_COMPONENT(T) using GenericTextComponent<T>::deinitialize, GenericTextComponent<T>::render, GenericTextComponent<T>::onWindowChange, GenericTextComponent<T>::editContent, GenericTextComponent<T>::layoutText, GenericTextComponent<T>::renderText, GenericTextComponent<T>::releaseGlyphAtlas, GenericTextComponent<T>::sGlyphAtlas, GenericTextComponent<T>::sFontPath, GenericTextComponent<T>::mTextQuads, GenericTextComponent<T>::mTextDestRect, GenericTextComponent<T>::mContent;
 
 
 /**
@@ -167,7 +247,6 @@ class GenericButtonComponent : public GenericTextBoxComponent<T> {
         virtual void onClick();
 
         const ComponentPreset kOnMouseOverPreset;
-        SDL_Texture* mTextTextureOnMouseOver = nullptr;
         SDL_Texture* mBoxTextureOnMouseOver = nullptr;
 
         const GameState* kTargetGameState = nullptr;
@@ -183,7 +262,7 @@ class GenericButtonComponent : public GenericTextBoxComponent<T> {
         std::function<void(void)> mCallback;
 };
 
-#define INCL_GENERIC_BUTTON_COMPONENT(T) using GenericButtonComponent<T>::initialize, GenericButtonComponent<T>::deinitialize, GenericButtonComponent<T>::render, GenericButtonComponent<T>::onWindowChange, GenericButtonComponent<T>::handleMouseEvent, GenericButtonComponent<T>::handleCursor, GenericButtonComponent<T>::onClick, GenericButtonComponent<T>::kOnMouseOverPreset, GenericButtonComponent<T>::mTextTextureOnMouseOver, GenericButtonComponent<T>::mBoxTextureOnMouseOver, GenericButtonComponent<T>::kTargetGameState;
+#define INCL_GENERIC_BUTTON_COMPONENT(T) using GenericButtonComponent<T>::initialize, GenericButtonComponent<T>::deinitialize, GenericButtonComponent<T>::render, GenericButtonComponent<T>::onWindowChange, GenericButtonComponent<T>::handleMouseEvent, GenericButtonComponent<T>::handleCursor, GenericButtonComponent<T>::onClick, GenericButtonComponent<T>::kOnMouseOverPreset, GenericButtonComponent<T>::mBoxTextureOnMouseOver, GenericButtonComponent<T>::kTargetGameState;
 
 
 template <typename T>
@@ -227,6 +306,50 @@ class GenericProgressBarComponent : public GenericBoxComponent<T> {
 #define INCL_GENERIC_PROGRESS_BAR_COMPONENT(T) using GenericProgressBarComponent<T>::render, GenericProgressBarComponent<T>::onWindowChange, GenericProgressBarComponent<T>::updateAnimation, GenericProgressBarComponent<T>::resetProgress, GenericProgressBarComponent<T>::isActivated, GenericProgressBarComponent<T>::isFinished;
 
 
+/**
+ * @brief Retain the composited UI i.e. components, in a window-sized texture, recompositing only the regions that components have invalidated.
+ * @note Components call `GenericComponent<T>::invalidate()` on state changes e.g. hover, content edit, window resize. A change of `globals::state` invalidates the whole window.
+*/
+class UICompositor final : public Singleton<UICompositor> {
+    public:
+        INCL_SINGLETON(UICompositor)
+
+        /**
+         * Figures of the latest frame.
+        */
+        struct Stats {
+            std::size_t recompositedPixels = 0;
+            std::size_t recompositedRects = 0;
+        };
+
+        UICompositor(std::function<void(void)> const& callable);
+        ~UICompositor();
+
+        void render();
+        void onWindowChange();
+
+        void invalidate(SDL_Rect const& rect);
+        void invalidateAll();
+
+        inline Stats const& getStats() const { return mStats; }
+
+    private:
+        void recomposite();
+
+        /**
+         * A function that calls the `render()` method of every component currently shown, in order.
+        */
+        const std::function<void(void)> kRenderMethod;
+
+        SDL_Texture* mTexture = nullptr;
+        SDL_Point mTextureSize = { 0, 0 };
+
+        std::vector<SDL_Rect> mDirtyRects;
+        GameState mPrevState = GameState::kExit;
+        Stats mStats;
+};
+
+
 /* Derived implementations */
 
 /**
@@ -269,6 +392,7 @@ class ExitText final : public Singleton<ExitText>, public GenericTextComponent<E
         const double kProgressUpdateRate = config::components::exit_text::progressUpdateRate;
 
         double mCurrProgress;
+        Uint8 mTextAlpha = SDL_ALPHA_TRANSPARENT;
 };
 
 
@@ -279,48 +403,68 @@ class IngameDialogueBox : public Singleton<IngameDialogueBox>, public GenericBox
         kUpdateComplete,
     };
     
+    /**
+     * @brief A glyph atlas for the dialogue text, spread over fixed-size pages that are filled on demand and evicted least-recently-used first.
+     * @note Printable ASCII is rasterized upfront; any other code point is rasterized upon first use, so that arbitrarily large character sets e.g. CJK work within a bounded amount of VRAM.
+     * @note Pages referenced by a `Layout` are pinned until the layout is released, and are never evicted in the meantime. Should every page be pinned, the page budget is exceeded rather than corrupting a layout.
+     * @note Bound to a single font size; `IngameDialogueBox` keeps one instance per recently used size.
+    */
     class BMPFont {
-        struct Data_Glyph_Storage {
-            int width;
-            int advance;
-        };
-
-        struct Data_Glyph_Query {
-            SDL_Rect srcRect;
+        struct Glyph {
+            std::size_t pageIndex;
+            SDL_Rect srcRect;   // Empty for code points the font does not provide
             int advance;
         };
 
-        class Map {
-            public:
-                Map() = default;
-                inline ~Map() { clear(); }
-
-                void insert(char c, Data_Glyph_Storage const& data);
-                inline void clear() { mGlyphDataUMap.clear(); }
-                Data_Glyph_Query operator[](char c) const;
-
-                inline void setGlyphHeight(int height) { mGlyphHeight = height; }
-
-            private:
-                int mGlyphHeight;
-                std::map<char, Data_Glyph_Storage> mGlyphDataUMap;
+        struct Page {
+            SDL_Texture* texture = nullptr;
+            SDL_Point shelfOrigin = { 0, 0 };
+            int shelfHeight = 0;
+            unsigned long long lastUsed = 0;
+            std::size_t pinCount = 0;
+            std::vector<Uint32> codepoints;   // Glyphs residing in this page, to be forgotten upon eviction
         };
 
         public:
-            BMPFont(ComponentPreset const& preset);
+            struct Quad {
+                std::size_t pageIndex;
+                SDL_Rect srcRect;
+                SDL_Rect destRect;   // Relative to the top-left corner of the text region
+            };
+
+            /**
+             * The state of a layout after each code point.
+            */
+            struct Step {
+                std::size_t quadCount;   // Quads revealed so far
+                std::size_t screenBegin;   // First quad on the same screen i.e. box-full of text
+            };
+
+            /**
+             * A content laid out once, as glyph quads with line and screen breaks resolved.
+            */
+            struct Layout {
+                std::vector<Quad> quads;
+                std::vector<Step> steps;
+                std::vector<std::size_t> pageIndices;   // Pinned
+            };
+
+            BMPFont(ComponentPreset const& preset, TTF_Font* font);
             ~BMPFont();
 
-            void load(TTF_Font* font);
-            void clear() const;
-            void render(char c) const;
+            Layout layout(std::string const& content, SDL_Point const& size);
+            void release(Layout& layout);
+            void render(Layout const& layout, Step const& step, SDL_Point const& origin) const;
 
-            void setRenderTarget(SDL_Texture*& targetTexture);
             inline void setSpacing(SDL_Point spacing) { mSpacing = spacing; }
 
         private:
-            std::string getChars() const;
-            void registerCharToMap(TTF_Font* font, char c);
-            void registerCharToTexture(TTF_Font* font, char c) const;
+            Glyph const* getGlyph(Uint32 codepoint);
+            std::optional<Glyph>& findGlyph(Uint32 codepoint);
+            void registerGlyph(Uint32 codepoint);
+            std::optional<std::size_t> allocate(SDL_Point const& size, SDL_Point& origin);
+            void evictPage(std::size_t pageIndex);
+            void clearPages();
 
             #if defined(__linux__)
             static constexpr auto sTextRenderMethod = TTF_RenderGlyph32_Shaded;
@@ -328,18 +472,33 @@ class IngameDialogueBox : public Singleton<IngameDialogueBox>, public GenericBox
             static constexpr auto sTextRenderMethod = TTF_RenderGlyph32_LCD;
             #endif
 
-            SDL_Texture* mTexture = nullptr;
-            SDL_Point mSrcSize;
-            Map mSrcRectsMap;
+            static constexpr Uint32 kASCIICount = 0x80;
+
+            /**
+             * The glyph table, populated lazily i.e. `std::nullopt` until rasterized. ASCII is directly indexed, the remaining code points are hashed; either way a lookup is `O(1)`.
+            */
+            std::array<std::optional<Glyph>, kASCIICount> mASCIIGlyphs;
+            std::unordered_map<Uint32, std::optional<Glyph>> mGlyphs;
+
+            std::vector<Page> mPages;
+            std::size_t mCurrPageIndex = 0;   // The page being filled
+            unsigned long long mUseCount = 0;
 
-            SDL_Texture* mTargetTexture = nullptr;
-            SDL_Point mTargetTextureSize;
+            TTF_Font* mFont = nullptr;
+            int mGlyphHeight = 0;
 
             ComponentPreset mPreset;
-            mutable SDL_Point mGlyphOrigin;
             SDL_Point mSpacing = { 0, 0 };
     };
 
+    /**
+     * A content along with its layout, computed upon being enqueued.
+    */
+    struct Dialogue {
+        std::string content;
+        BMPFont::Layout layout;
+    };
+
     public:
         INCL_GENERIC_BOX_COMPONENT(IngameDialogueBox)
         INCL_SINGLETON(IngameDialogueBox)
@@ -361,23 +520,28 @@ class IngameDialogueBox : public Singleton<IngameDialogueBox>, public GenericBox
 
         void close();
         void skip();
+        void enqueue(std::string const& content);
+        void loadBMPFont(int fontSize);
 
         // Prevent "inescapable" dialogue
         static constexpr unsigned short int sDelayCounterLimit = config::components::dialogue_box::delayCounterLimit;
         unsigned short int mDelayCounter = sDelayCounterLimit;
 
-        TTF_Font* mFont = nullptr;
         static const std::filesystem::path sFontPath;
 
         Status mStatus = Status::kInactive;
 
-        BMPFont mBMPFont;
-        SDL_Texture* mTextTexture = nullptr;
+        /**
+         * Fonts by size, so that returning to a recent window size does not rasterize anything anew. `mBMPFontSizes` is ordered from least to most recently used.
+        */
+        std::map<int, std::unique_ptr<BMPFont>> mBMPFonts;
+        std::deque<int> mBMPFontSizes;
+        BMPFont* mBMPFont = nullptr;
         SDL_Rect mTextDestRect;
         static constexpr inline double mTextTextureOffsetRatio = config::components::dialogue_box::destOffsetRatio;
 
-        std::queue<std::string> mContents;
-        unsigned short int mCurrProgress;
+        std::deque<Dialogue> mDialogues;
+        std::size_t mCurrProgress;   // Index into the steps of the front dialogue
 };
 
 
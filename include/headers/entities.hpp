@@ -1,8 +1,11 @@
 #ifndef ENTITIES_H
 #define ENTITIES_H
 
+#include <algorithm>
 #include <filesystem>
 #include <functional>
+#include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -15,10 +18,107 @@
 
 #include <timers.hpp>
 #include <mixer.hpp>
+#include <loader.hpp>
 #include <meta.hpp>
 #include <auxiliaries.hpp>
 
 
+/* Shared data */
+
+/**
+ * @brief A read-only sample of the player's state, taken once per tick and shared by every hostile during the decision pass.
+ * @note Replaces the per-hostile `Player` request/response events i.e. hostiles no longer wait one frame for a reply.
+*/
+struct PlayerSnapshot {
+    SDL_Point destCoords;
+    Animation animation;
+};
+
+
+/**
+ * @brief A uniform grid over the level, used to find the instances of one entity type that intersect a region e.g. the camera.
+ * @note Instances are bucketed by the top-left corner of their `SDL_Rect`. Queries are widened by the largest rect dimensions seen, so that instances anchored in neighbouring buckets are not missed.
+ * @note Buckets reference rects rather than copy them, so that moves within a bucket require no update, and moves across buckets only `relocate()`.
+*/
+template <typename T>
+class SpatialGrid {
+    public:
+        void reset(SDL_Point const& boundsSize, SDL_Point const& bucketSize) {
+            mBucketSize = { std::max(bucketSize.x, 1), std::max(bucketSize.y, 1) };
+            mBucketCount = { std::max((boundsSize.x + mBucketSize.x - 1) / mBucketSize.x, 1), std::max((boundsSize.y + mBucketSize.y - 1) / mBucketSize.y, 1) };
+            mMaxExtent = { 0, 0 };
+            mSize = 0;
+
+            mBuckets.resize(mBucketCount.x * mBucketCount.y);
+            for (auto& bucket : mBuckets) bucket.clear();   // Retain capacity across rebuilds
+        }
+
+        /**
+         * @note `rect` must outlive the entry e.g. be a member of `instance`.
+        */
+        void insert(T* instance, SDL_Rect const& rect) {
+            mBuckets[toIndex(rect.x, rect.y)].push_back({ instance, &rect });
+            mMaxExtent = { std::max(mMaxExtent.x, rect.w), std::max(mMaxExtent.y, rect.h) };
+            ++mSize;
+        }
+
+        /**
+         * @brief Move `instance` to the bucket of its rect, now at `rect`, from the bucket of `prevRect`.
+         * @return `false` if `instance` was not bucketed by `prevRect`, in which case the grid should be rebuilt.
+        */
+        bool relocate(T* instance, SDL_Rect const& prevRect, SDL_Rect const& rect) {
+            mMaxExtent = { std::max(mMaxExtent.x, rect.w), std::max(mMaxExtent.y, rect.h) };
+
+            auto prevIndex = toIndex(prevRect.x, prevRect.y);
+            auto index = toIndex(rect.x, rect.y);
+            if (prevIndex == index) return true;
+
+            auto& prevBucket = mBuckets[prevIndex];
+            auto it = std::find_if(prevBucket.begin(), prevBucket.end(), [&](auto const& entry) { return entry.first == instance; });
+            if (it == prevBucket.end()) return false;
+
+            mBuckets[index].push_back(*it);
+            *it = prevBucket.back();
+            prevBucket.pop_back();
+            return true;
+        }
+
+        /**
+         * @brief Call `callable` on every instance whose rect intersects `rect`.
+         * @return The number of such instances.
+        */
+        template <typename Callable>
+        std::size_t query(SDL_Rect const& rect, Callable&& callable) const {
+            if (!mSize) return 0;
+
+            auto [x0, y0] = toBucket(rect.x - mMaxExtent.x, rect.y - mMaxExtent.y);
+            auto [x1, y1] = toBucket(rect.x + rect.w, rect.y + rect.h);
+            std::size_t count = 0;
+
+            for (int y = y0; y <= y1; ++y) for (int x = x0; x <= x1; ++x) for (const auto& [instance, instanceRect] : mBuckets[y * mBucketCount.x + x]) {
+                if (!SDL_HasIntersection(&rect, instanceRect)) continue;
+                std::invoke(callable, instance);
+                ++count;
+            }
+
+            return count;
+        }
+
+        inline std::size_t size() const { return mSize; }
+
+    private:
+        inline std::pair<int, int> toBucket(int x, int y) const { return { std::clamp(x / mBucketSize.x, 0, mBucketCount.x - 1), std::clamp(y / mBucketSize.y, 0, mBucketCount.y - 1) }; }
+        inline int toIndex(int x, int y) const { auto [bx, by] = toBucket(x, y); return by * mBucketCount.x + bx; }
+
+        SDL_Point mBucketSize = { 1, 1 };
+        SDL_Point mBucketCount = { 1, 1 };
+        SDL_Point mMaxExtent = { 0, 0 };
+        std::size_t mSize = 0;
+
+        std::vector<std::vector<std::pair<T*, SDL_Rect const*>>> mBuckets = std::vector<std::vector<std::pair<T*, SDL_Rect const*>>>(1);
+};
+
+
 /* Abstract templates */
 
 /**
@@ -39,6 +139,8 @@ class AbstractEntity : public Multiton<T> {
         virtual ~AbstractEntity() = default;
 
         static void initialize();
+        static void initializeAsync();
+        static void awaitInitialize();
         static void deinitialize();
         static void reinitialize(std::filesystem::path path);
 
@@ -70,6 +172,20 @@ class AbstractEntity : public Multiton<T> {
         virtual void onWindowChange();
         virtual void onLevelChange(level::Data_Generic const& entityLevelData);
 
+        inline void savePrevDestRect() { mPrevDestRect = mDestRect; }
+        void interpolateDestRect(double alpha);
+
+        /**
+         * @brief Call `method` on each instance of derived class `T` whose `mDestRect` intersects `rect`, found through `sSpatialGrid`.
+         * @return The number of instances called.
+        */
+        template <typename Callable, typename... Args>
+        static std::size_t invokeWithin(SDL_Rect const& rect, Callable&& callable, Args&&... args) {
+            if (instances.empty()) return 0;
+            if (sIsSpatialGridOutdated || sSpatialGrid.size() != instances.size()) updateSpatialGrid();   // Removals are caught by the size mismatch
+            return sSpatialGrid.query(rect, [&](T* instance) { std::invoke(callable, *instance, args...); });
+        }
+
         virtual void handleCustomEventPOST() const {}
         virtual void handleCustomEventGET(SDL_Event const& event) {}
 
@@ -83,6 +199,15 @@ class AbstractEntity : public Multiton<T> {
         AbstractEntity(SDL_Point const& destCoords);
 
         SDL_Rect getDestRectFromCoords(SDL_Point const& coords) const;
+        static inline void invalidateSpatialGrid() { sIsSpatialGridOutdated = true; }
+
+        /**
+         * @brief Re-bucket this instance alone after `mDestRect` moved from `prevDestRect`, instead of rebuilding `sSpatialGrid`.
+        */
+        inline void relocateWithinSpatialGrid(SDL_Rect const& prevDestRect) {
+            if (sIsSpatialGridOutdated) return;   // Rebuilt upon the next query regardless
+            if (!sSpatialGrid.relocate(static_cast<T*>(this), prevDestRect, mDestRect)) invalidateSpatialGrid();
+        }
         static bool isTargetWithinRange(SDL_Point const& targetDestCoords, std::pair<int, int> const& x_coords_lim, std::pair<int, int> const& y_coords_lim);
 
         static const char* sTypeID;
@@ -95,6 +220,16 @@ class AbstractEntity : public Multiton<T> {
         SDL_Rect mSrcRect;
         SDL_Rect mDestRect;
 
+        /**
+         * `mDestRect` as of the start of the latest simulation tick. Empty until the first tick, or after a discontinuity e.g. window or level change.
+        */
+        std::optional<SDL_Rect> mPrevDestRect;
+
+        /**
+         * The rendered position, between `mPrevDestRect` and `mDestRect`. Tracks render frames rather than simulation ticks.
+        */
+        SDL_Rect mInterpolatedDestRect;
+
         /**
          * Modify `mDestRect`.
          * @param x a value of `k` specifies that `destRect.x` would be shifted by `k * globals::tileDestSize.x` pixels.
@@ -113,7 +248,13 @@ class AbstractEntity : public Multiton<T> {
         mutable EntityAttributes mAttributes;
 
     private:
+        static void updateSpatialGrid();
+
         static int sID_Counter;
+        static std::optional<AssetLoader::TaskID> sInitializeTask;
+
+        static SpatialGrid<T> sSpatialGrid;
+        static bool sIsSpatialGridOutdated;
 };
 
 namespace std {
@@ -128,7 +269,7 @@ namespace std {
     };
 };
 
-#define INCL_ABSTRACT_ENTITY(T) using AbstractEntity<T>::initialize, AbstractEntity<T>::deinitialize, AbstractEntity<T>::reinitialize, AbstractEntity<T>::onLevelChangeAll, AbstractEntity<T>::instantiateEX, AbstractEntity<T>::render, AbstractEntity<T>::onWindowChange, AbstractEntity<T>::onLevelChange, AbstractEntity<T>::handleCustomEventPOST, AbstractEntity<T>::handleCustomEventGET, AbstractEntity<T>::isWithinRange, AbstractEntity<T>::syncPlayerMovement, AbstractEntity<T>::getDestRectFromCoords, AbstractEntity<T>::isTargetWithinRange, AbstractEntity<T>::mID, AbstractEntity<T>::sTilesetPath, AbstractEntity<T>::sTilesetData, AbstractEntity<T>::mDestCoords, AbstractEntity<T>::mSrcRect, AbstractEntity<T>::mDestRect, AbstractEntity<T>::mDestRectModifier, AbstractEntity<T>::mAngle, AbstractEntity<T>::mCenter, AbstractEntity<T>::mFlip, AbstractEntity<T>::mAttributes;
+#define INCL_ABSTRACT_ENTITY(T) using AbstractEntity<T>::initialize, AbstractEntity<T>::initializeAsync, AbstractEntity<T>::awaitInitialize, AbstractEntity<T>::deinitialize, AbstractEntity<T>::reinitialize, AbstractEntity<T>::onLevelChangeAll, AbstractEntity<T>::instantiateEX, AbstractEntity<T>::render, AbstractEntity<T>::onWindowChange, AbstractEntity<T>::onLevelChange, AbstractEntity<T>::savePrevDestRect, AbstractEntity<T>::interpolateDestRect, AbstractEntity<T>::invokeWithin, AbstractEntity<T>::handleCustomEventPOST, AbstractEntity<T>::handleCustomEventGET, AbstractEntity<T>::isWithinRange, AbstractEntity<T>::syncPlayerMovement, AbstractEntity<T>::getDestRectFromCoords, AbstractEntity<T>::invalidateSpatialGrid, AbstractEntity<T>::relocateWithinSpatialGrid, AbstractEntity<T>::isTargetWithinRange, AbstractEntity<T>::mID, AbstractEntity<T>::sTilesetPath, AbstractEntity<T>::sTilesetData, AbstractEntity<T>::mDestCoords, AbstractEntity<T>::mSrcRect, AbstractEntity<T>::mDestRect, AbstractEntity<T>::mPrevDestRect, AbstractEntity<T>::mInterpolatedDestRect, AbstractEntity<T>::mDestRectModifier, AbstractEntity<T>::mAngle, AbstractEntity<T>::mCenter, AbstractEntity<T>::mFlip, AbstractEntity<T>::mAttributes;
 
 
 /**
@@ -140,7 +281,7 @@ class AbstractAnimatedEntity : public AbstractEntity<T> {
         INCL_MULTITON(T)
         INCL_ABSTRACT_ENTITY(T)
 
-        virtual ~AbstractAnimatedEntity() = default;
+        virtual ~AbstractAnimatedEntity();
 
         static void reinitialize(std::filesystem::path path);
 
@@ -163,9 +304,16 @@ class AbstractAnimatedEntity : public AbstractEntity<T> {
         SDL_Point mDirection = tile::Data_EntityTileset::kDefaultDirection;
 
     private:
+        void scheduleAnimationTimer();
+        void onAnimationTimerFinished();
+
         tile::Data_EntityTileset::Data_Animation mAnimationData;
-        CountdownTimer mAnimationTimer;
+        CountdownTimer mAnimationTimer;   // Measures the elapsed time only, expiry is signalled by `TimerWheel`
+        TimerWheel::Handle mAnimationTimerHandle = TimerWheel::kInvalidHandle;
+        unsigned long long int mAnimationTimerExpiryTick = std::numeric_limits<unsigned long long int>::max();
         int mAnimationGID;
+
+        mutable bool mWasAnimationAtFirstSprite = false;   // As of the previous `handleSFX()`
 };
 
 #define INCL_ABSTRACT_ANIMATED_ENTITY(T) using AbstractAnimatedEntity<T>::reinitialize, AbstractAnimatedEntity<T>::onLevelChange, AbstractAnimatedEntity<T>::handleSFX, AbstractAnimatedEntity<T>::updateAnimation, AbstractAnimatedEntity<T>::resetAnimation, AbstractAnimatedEntity<T>::isAnimationAtSprite, AbstractAnimatedEntity<T>::isAnimationAtFirstSprite, AbstractAnimatedEntity<T>::isAnimationAtFinalSprite, AbstractAnimatedEntity<T>::mBaseAnimation, AbstractAnimatedEntity<T>::mAnimation, AbstractAnimatedEntity<T>::mDirection;
@@ -402,10 +550,10 @@ class GenericHostileEntity : public AbstractAnimatedDynamicEntity<T> {
         INCL_ABSTRACT_ANIMATED_ENTITY(T)
         INCL_ABSTRACT_ANIMATED_DYNAMIC_ENTITY(T)
 
-        ~GenericHostileEntity() { --sDeathCount; }
+        ~GenericHostileEntity();
 
-        void handleCustomEventPOST() const override;
         void handleCustomEventGET(SDL_Event const& event) override;
+        void handleDecision(PlayerSnapshot const& snapshot);
 
         static inline unsigned int getDeathCount() { return sDeathCount; }
         static inline bool isAllDead() { return sDeathCount == static_cast<unsigned int>(instances.size()); }
@@ -416,34 +564,10 @@ class GenericHostileEntity : public AbstractAnimatedDynamicEntity<T> {
         GenericHostileEntity(SDL_Point const& destCoords);
 
     private:
-        template <event::Code C>
-        typename std::enable_if_t<C == event::Code::kReq_AttackRegister_GHE_Player>
-        handleCustomEventPOST_impl() const;
-
-        template <event::Code C>
-        typename std::enable_if_t<C == event::Code::kReq_AttackInitiate_GHE_Player>
-        handleCustomEventPOST_impl() const;
-
-        template <event::Code C>
-        typename std::enable_if_t<C == event::Code::kReq_MoveInitiate_GHE_Player>
-        handleCustomEventPOST_impl() const;
-
         template <event::Code C>
         typename std::enable_if_t<C == event::Code::kReq_AttackRegister_Player_GHE>
         handleCustomEventGET_impl(SDL_Event const& event);
 
-        template <event::Code C>
-        typename std::enable_if_t<C == event::Code::kResp_AttackInitiate_GHE_Player>
-        handleCustomEventGET_impl();
-
-        template <event::Code C>
-        typename std::enable_if_t<C == event::Code::kResp_MoveInitiate_GHE_Player>
-        handleCustomEventGET_impl(SDL_Event const& event);
-
-        template <event::Code C>
-        typename std::enable_if_t<C == event::Code::kResp_MoveTerminate_GHE_Player>
-        handleCustomEventGET_impl();
-
         template <MovementSelectionType M_ = M>
         typename std::enable_if_t<M_ == MovementSelectionType::kGreedyTrigonometric>
         calculateNextMovement(SDL_Point const& targetDestCoords);
@@ -456,10 +580,32 @@ class GenericHostileEntity : public AbstractAnimatedDynamicEntity<T> {
         typename std::enable_if_t<M_ == MovementSelectionType::kPathfindingAStar>
         calculateNextMovement(SDL_Point const& targetDestCoords);
 
+        template <MovementSelectionType M_ = M>
+        typename std::enable_if_t<M_ == MovementSelectionType::kPathfindingDijkstra>
+        calculateNextMovement(SDL_Point const& targetDestCoords);
+
+        template <MovementSelectionType M_ = M>
+        typename std::enable_if_t<M_ == MovementSelectionType::kPathfindingAsync>
+        calculateNextMovement(SDL_Point const& targetDestCoords);
+
+        /**
+         * State of `calculateNextMovement<MovementSelectionType::kPathfindingAStar>()`. The planner keeps its search state across decisions, and is only allocated by instances that use it.
+        */
+        std::unique_ptr<pathfinders::DSLPF> mPlanner;
+        pathfinders::Cell mPlannerAnchor = { 0, 0 };
+        CountdownTimer mReplanTimer = CountdownTimer(config::entities::ASPFTicks);
+
+        /**
+         * Followed by `calculateNextMovement<MovementSelectionType::kPathfindingAStar>()` and `calculateNextMovement<MovementSelectionType::kPathfindingAsync>()`. The path is in reverse order i.e. `back()` comes first.
+        */
+        std::vector<pathfinders::Cell> mPath;
+        pathfinders::PathService::Ticket mTicket = pathfinders::PathService::kInvalidTicket;
+        SDL_Point mRequestedDestCoords = { -1, -1 };
+
         static unsigned int sDeathCount;
 };
 
-#define INCL_GENERIC_HOSTILE_ENTITY(T, M) using GenericHostileEntity<T, M>::handleCustomEventPOST, GenericHostileEntity<T, M>::handleCustomEventGET, GenericHostileEntity<T, M>::getDeathCount, GenericHostileEntity<T, M>::isAllDead, GenericHostileEntity<T, M>::instantiateMeteorProjectileOnSelf;
+#define INCL_GENERIC_HOSTILE_ENTITY(T, M) using GenericHostileEntity<T, M>::handleCustomEventGET, GenericHostileEntity<T, M>::handleDecision, GenericHostileEntity<T, M>::getDeathCount, GenericHostileEntity<T, M>::isAllDead, GenericHostileEntity<T, M>::instantiateMeteorProjectileOnSelf;
 
 #define DECL_GENERIC_HOSTILE_ENTITY(T, M) \
 class T final : public GenericHostileEntity<T, M> {\
@@ -571,6 +717,7 @@ class PlaceholderInteractable : public GenericInteractable<PlaceholderInteractab
         ~PlaceholderInteractable() = default;
 
         static void initialize() {}
+        static void initializeAsync() {}
 
         void render() const override {}
         void onWindowChange() override {}
@@ -587,6 +734,7 @@ class PlaceholderTeleporter : public GenericTeleporterEntity<PlaceholderTeleport
         ~PlaceholderTeleporter() = default;
 
         static void initialize() {}
+        static void initializeAsync() {}
 
         void render() const override {}
         void onWindowChange() override {}
@@ -614,7 +762,9 @@ class Player final : public Singleton<Player>, public AbstractAnimatedDynamicEnt
         void handleCustomEventGET(SDL_Event const& event) override;
         void handleSFX() const override;
 
-        inline bool isOnAutopilot() const { return !mAutopilotPath.empty(); }
+        void onAttackRegistered(EntityAttributes& attributes, SDL_Point const& destCoords);
+
+        inline bool isOnAutopilot() const { return mAutopilotDestCoords.has_value(); }
         void handleAutopilotMovement();
 
         inline auto getDestCoordsDifference() const { return mDifferenceDestCoords; }
@@ -626,6 +776,7 @@ class Player final : public Singleton<Player>, public AbstractAnimatedDynamicEnt
         void handleKeyboardEvent_MeteorShowerAttack(SDL_Event const& event);
 
         void onAutopilotToggled(bool onAutopilotStart);
+        void refineAutopilotPath();
 
         template <event::Code C>
         typename std::enable_if_t<C == event::Code::kReq_AttackRegister_Player_GHE>
@@ -639,25 +790,23 @@ class Player final : public Singleton<Player>, public AbstractAnimatedDynamicEnt
         typename std::enable_if_t<C == event::Code::kReq_Interact_Player_GIE>
         handleCustomEventPOST_impl() const;
 
-        template <event::Code C>
-        typename std::enable_if_t<C == event::Code::kReq_AttackRegister_GHE_Player>
-        handleCustomEventGET_impl(SDL_Event const& event);
-
-        template <event::Code C>
-        typename std::enable_if_t<C == event::Code::kResp_AttackInitiate_GHE_Player>
-        handleCustomEventGET_impl(SDL_Event const& event);
-
-        template <event::Code C>
-        typename std::enable_if_t<C == event::Code::kResp_MoveInitiate_GHE_Player>
-        handleCustomEventGET_impl(SDL_Event const& event);
-
         template <event::Code C>
         typename std::enable_if_t<C == event::Code::kResp_Teleport_GTE_Player>
         handleCustomEventGET_impl(SDL_Event const& event);
 
         static const std::vector<std::filesystem::path> sTilesetPaths;
 
-        std::stack<pathfinders::Cell> mAutopilotPath;
+        /**
+         * The tile the player is expected to stand on before the next autopilot step is looked up.
+        */
+        std::optional<SDL_Point> mAutopilotDestCoords;
+        bool mIsAutopilotOnFlowField = false;   // Otherwise on `pathfinders::hierarchy`
+
+        /**
+         * Both in reverse order i.e. `back()` comes first. Waypoints are refined into `mAutopilotPath` one at a time, as the player reaches them.
+        */
+        std::vector<pathfinders::Cell> mAutopilotWaypoints;
+        std::vector<pathfinders::Cell> mAutopilotPath;
 
         SDL_Point mCachedDestCoords;
         SDL_Point mCachedDestRect;
@@ -689,13 +838,13 @@ DECL_GENERIC_INTERACTABLE(OmoriCat_7)
 DECL_GENERIC_TELEPORTER_ENTITY(RedHandThrone)
 #define TELEPORTERS RedHandThrone
 
-DECL_GENERIC_HOSTILE_ENTITY_(CommonHooded)
-DECL_GENERIC_HOSTILE_ENTITY_(CommonSatyr)
-DECL_GENERIC_HOSTILE_ENTITY_(CommonChickenBoy)
-DECL_GENERIC_HOSTILE_ENTITY_(ElitePlagueCrow)
-DECL_GENERIC_HOSTILE_ENTITY_(EliteDarkSamurai)
-DECL_GENERIC_HOSTILE_ENTITY_(BossRedHood)
-DECL_GENERIC_HOSTILE_ENTITY_(BossNightBorne)
+DECL_GENERIC_HOSTILE_ENTITY(CommonHooded, MovementSelectionType::kPathfindingAStar)   // Short-ranged, hence searches stay within the planner window
+DECL_GENERIC_HOSTILE_ENTITY(CommonSatyr, MovementSelectionType::kPathfindingAStar)
+DECL_GENERIC_HOSTILE_ENTITY(CommonChickenBoy, MovementSelectionType::kPathfindingAStar)
+DECL_GENERIC_HOSTILE_ENTITY(ElitePlagueCrow, MovementSelectionType::kPathfindingAsync)   // Chase across the whole level, hence search off the main thread
+DECL_GENERIC_HOSTILE_ENTITY(EliteDarkSamurai, MovementSelectionType::kPathfindingAsync)
+DECL_GENERIC_HOSTILE_ENTITY(BossRedHood, MovementSelectionType::kPathfindingAsync)
+DECL_GENERIC_HOSTILE_ENTITY(BossNightBorne, MovementSelectionType::kPathfindingAsync)
 DECL_GENERIC_HOSTILE_ENTITY_(Egg)
 DECL_GENERIC_HOSTILE_ENTITY_(EnergySphere)
 #define HOSTILES CommonHooded, CommonSatyr, CommonChickenBoy, ElitePlagueCrow, EliteDarkSamurai, BossRedHood, BossNightBorne, Egg, EnergySphere
@@ -721,20 +870,35 @@ class Invoker {
             (Ts::func(), ...);\
         };
 
+    #define DECL_WITHIN(func) \
+        template <typename... Args>\
+        static inline std::size_t invoke_##func##Within(SDL_Rect const& rect, Args&&... args) {\
+            return (Ts::invokeWithin(rect, &Ts::func, std::forward<Args>(args)...) + ... + 0);\
+        };
+
     public:
         DECL_STATIC(initialize)
+        DECL_STATIC(initializeAsync)
         DECL_STATIC(deinitialize)
         DECL_STATIC(onLevelChangeAll)
 
         DECL(render)
         DECL(onWindowChange)
+        DECL(savePrevDestRect)
+        DECL(interpolateDestRect)
         DECL(handleCustomEventGET)
         DECL(handleCustomEventPOST)
         DECL(updateAnimation)
         DECL(move)
         DECL(handleInstantiation)
+        DECL(handleDecision)
         DECL(handleSFX)
         DECL(instantiateMeteorProjectileOnSelf)
+
+        DECL_WITHIN(render)
+        DECL_WITHIN(updateAnimation)
+
+        static inline std::size_t count() { return (Ts::instances.size() + ... + 0); }
 };
 
 
@@ -35,9 +35,11 @@ class Game final : public Singleton<Game> {
         void handleDependencies();
         void handleEvents();
         void render() const;
+        void reportFrame() const;
 
         void onLevelChange();
         void onWindowChange();
+        void handleWindowChange();
 
         void handleWindowEvent(SDL_Event const& event);
         void handleKeyBoardEvent(SDL_Event const& event) const;
@@ -52,6 +54,9 @@ class Game final : public Singleton<Game> {
         SDL_Surface* mWindowSurface = nullptr;
         Uint32 mWindowID;
 
+        bool mIsWindowChangePending = false;
+        double mLastWindowChangeMilliseconds = 0;   // In `FrameClock::getMilliseconds()` time
+
         const GameInitFlag mFlags;
         SDL_Rect mWindowDimension;
         const int mFPS;
@@ -51,6 +51,7 @@ class IngameMapHandler final : public AbstractInterface<IngameMapHandler> {
         static void initialize();
         
         void render() const override;
+        void renderWithin(SDL_Rect const& rect) const;
         void onLevelChange();
         void onWindowChange() override;
         void handleKeyBoardEvent(SDL_Event const& event);
@@ -61,11 +62,22 @@ class IngameMapHandler final : public AbstractInterface<IngameMapHandler> {
         bool isOnGrayscale = false;
 
     private:
+        /**
+         * A tile of one tilelayer, resolved to its tileset once per level.
+        */
+        struct TileSprite {
+            SDL_Texture* texture;
+            SDL_Rect srcRect;
+            int layer;   // Index of the tilelayer
+        };
+
         void loadLevel() const;
+        void loadTileSprites();
+        void loadGrayscaleTilesets();
+        void clearGrayscaleTilesets();
 
-        void renderToTexture();
-        void renderBackground() const;
-        void renderLevelTilelayers() const;
+        void renderBackground(SDL_Rect const& rect) const;
+        void renderLevelTilelayers(SDL_Rect const& rect) const;
 
         level::Name mLevelName;
 
@@ -76,9 +88,15 @@ class IngameMapHandler final : public AbstractInterface<IngameMapHandler> {
         static level::Map sLevelMap;
 
         /**
-         * A grayscaled version of `texture`.
+         * Renderable tiles of all tilelayers, grouped by cell in row-major order i.e. those of cell `(x, y)` span `[mTileSpriteOffsets[i], mTileSpriteOffsets[i + 1])` where `i = y * level::data.tileDestCount.x + x`.
         */
-        SDL_Texture* mGrayscaleTexture = nullptr;
+        std::vector<TileSprite> mTileSprites;
+        std::vector<std::size_t> mTileSpriteOffsets;
+
+        /**
+         * Maps a tileset texture to its grayscaled version.
+        */
+        std::unordered_map<SDL_Texture*, SDL_Texture*> mGrayscaleTilesets;
 };
 
 
@@ -94,10 +112,22 @@ class IngameViewHandler final : public AbstractInterface<IngameViewHandler> {
     public:
         INCL_ABSTRACT_INTERFACE(IngameViewHandler)
 
-        IngameViewHandler(std::function<void()> const& callable, SDL_Rect& targetedEntityDestRect);
+        /**
+         * Entity counts of the latest frame, split by whether they fell within `getCullingRect()`.
+        */
+        struct CullingStats {
+            std::size_t drawn = 0;
+            std::size_t culled = 0;
+        };
+
+        IngameViewHandler(std::function<CullingStats(SDL_Rect const&)> const& callable, SDL_Rect& targetedEntityDestRect);
         ~IngameViewHandler() = default;
 
         void render() const override;
+
+        SDL_Rect getVisibleRect() const;
+        SDL_Rect getCullingRect() const;
+        inline CullingStats const& getCullingStats() const { return mCullingStats; }
         void onWindowChange() override;
         void onLevelChange();
         void handleKeyBoardEvent(SDL_Event const& event);
@@ -108,9 +138,9 @@ class IngameViewHandler final : public AbstractInterface<IngameViewHandler> {
         friend class IngameInterface;   // Provide access to private member `mTileCountWidth` and `mTileCountHeight`
 
         /**
-         * A function with `void` return type that calls all `render()` method on all dependencies. Dependencies are other entities and the map, and not UI components, for example.
+         * A function that calls all `render()` method on all dependencies within the given region of the level. Dependencies are other entities and the map, and not UI components, for example.
         */
-        const std::function<void()> kRenderMethod;
+        const std::function<CullingStats(SDL_Rect const&)> kRenderMethod;
         View mView = View::kTargetEntity;
 
         SDL_Point mTileDestSize;   // Not to be confused with `globals::tileDestSize`.
@@ -120,6 +150,8 @@ class IngameViewHandler final : public AbstractInterface<IngameViewHandler> {
         SDL_Rect& mTargetedEntityDestRect;   // Read-only
         mutable SDL_Rect mViewport;   // Prevent warning: `note: the first difference of corresponding definitions is field 'mTargetedEntityDestRect'`
         SDL_Rect mDestRect;
+
+        mutable CullingStats mCullingStats;
 };
 
 
@@ -139,8 +171,8 @@ class IngameInterface final : public Singleton<IngameInterface> {
         inline void increment() const { return set(get() + 1); }
         inline void decrement() const { if (get() > 0) set(get() - 1); }
 
-        void loadfromjson(json const& data) const;
-        json& savetojson(json& data) const;
+        inline std::unordered_map<level::Name, std::size_t> const& snapshot() const { return mProgress; }
+        inline void restore(std::unordered_map<level::Name, std::size_t> const& progress) const { mProgress = progress; }
 
         private:
             mutable std::unordered_map<level::Name, std::size_t> mProgress;
@@ -151,17 +183,48 @@ class IngameInterface final : public Singleton<IngameInterface> {
             friend IngameInterface;
             void loadfromfile() const;
             void clear() const;
+            inline void flush() const { mWriter.flush(); }
 
             private:
+                /**
+                 * Everything that is saved, copied on the main thread so that encoding and writing may happen on `mWriter`.
+                */
+                struct Snapshot {
+                    level::Name level;
+                    SDL_Point player;
+                    std::unordered_map<level::Name, std::size_t> progress;
+                };
+
+                /**
+                 * Precedes the payload, a sequence of native-endian integers.
+                */
+                struct Header {
+                    std::array<char, 4> magic;
+                    Uint16 version;
+                    Uint16 reserved;
+                    Uint32 payloadSize;
+                    Uint32 checksum;   // CRC-32 of the payload
+                };
+
+                static constexpr std::array<char, 4> kMagic = { 'S', 'A', 'V', 'E' };
+                static constexpr Uint16 kVersion = 1;
+
                 inline SaveHandler(ProgressHandler const& progress, std::filesystem::path const& path) : mProgress(progress), mPath(path) {}
 
-                json savetojson() const;
-                void savetofile(json const& data) const;
-                inline void savetofile() const { return savetofile(savetojson()); }
+                Snapshot snapshot() const;
+                void restore(Snapshot const& snapshot) const;
+                void savetofile() const;
+
+                static std::optional<Snapshot> readfromfile(std::filesystem::path const& path);
+                static std::string encode(Snapshot const& snapshot);
+                static std::optional<Snapshot> decode(std::vector<char> const& data);
+                static json tojson(Snapshot const& snapshot);
+                static std::optional<Snapshot> fromjson(json const& data);
 
                 mutable std::optional<SDL_Point> mPL;
                 ProgressHandler const& mProgress;
                 std::filesystem::path const& mPath;
+                mutable FileWriter mWriter;
         };
         
         INCL_SINGLETON(IngameInterface);
@@ -228,6 +291,7 @@ class MenuInterface final : public AbstractInterface<MenuInterface> {
         static void deinitialize();
 
         void render() const override;
+        void renderComponents() const;
         void onWindowChange() override;
         void updateAnimation();
 
@@ -235,7 +299,6 @@ class MenuInterface final : public AbstractInterface<MenuInterface> {
 
     private:
         void renderBackground() const;
-        void renderComponents() const;
 };
 
 
@@ -284,13 +347,13 @@ class GameOverInterface final : public AbstractInterface<GameOverInterface> {
         static void deinitialize();
 
         void render() const override;
+        void renderComponents() const;
         void onWindowChange() override;
 
         void handleMouseEvent(SDL_Event const& event);
 
     private:
         void renderBackground() const;
-        void renderComponents() const;
 };
 
 
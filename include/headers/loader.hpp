@@ -0,0 +1,98 @@
+#ifndef LOADER_H
+#define LOADER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SDL.h>
+
+#include <meta.hpp>
+#include <auxiliaries.hpp>
+
+
+/**
+ * @brief Load startup assets on a pool of worker threads, leaving only what requires the renderer to the main thread.
+ * @note A task is split into `decode` e.g. parsing XML or decoding images to `SDL_Surface`, which runs on a worker, and `finalize` e.g. creating textures, which runs on the main thread once the task is decoded. Tasks are independent of one another.
+ * @note Tasks are finalized on demand by `wait()`, or progressively within the budget given to `finalize()`, so that the menu does not wait for in-game assets.
+ * @note Every method should be called from the main thread.
+*/
+class AssetLoader final : public Singleton<AssetLoader> {
+    public:
+        using TaskID = std::size_t;
+
+        struct Task {
+            std::function<void(void)> decode;   // Must not touch the renderer
+            std::function<void(void)> finalize;
+        };
+
+        /**
+         * A point in time during startup, in wall-clock milliseconds since construction.
+        */
+        struct Phase {
+            std::string name;
+            double milliseconds;
+        };
+
+        struct Stats {
+            std::size_t taskCount = 0;
+            double decodeMilliseconds = 0;   // Summed across workers
+            double finalizeMilliseconds = 0;   // On the main thread
+        };
+
+        INCL_SINGLETON(AssetLoader)
+
+        AssetLoader(std::size_t workerCount);
+        ~AssetLoader();
+
+        TaskID submit(Task const& task);
+        void wait(TaskID id);
+        void waitAll();
+        void finalize(double budgetMilliseconds);
+
+        void markPhase(std::string const& name);
+        inline std::vector<Phase> const& getPhases() const { return mPhases; }
+        Stats getStats() const;
+
+    private:
+        enum class Status : unsigned char {
+            kPending,
+            kDecoded,
+            kFinalized,
+        };
+
+        struct Entry {
+            Task task;
+            Status status = Status::kPending;
+        };
+
+        void work();
+        Status getStatus(Entry const& entry) const;
+        bool isFinalizable(Entry const& entry) const;
+        void finalizeEntry(Entry& entry);
+        double now() const;
+
+        std::vector<std::thread> mWorkers;
+        Uint64 mBaseCounter;
+
+        // Shared with workers, guarded by `mMutex`. Elements of a `std::deque` are not relocated by `push_back()`, hence workers may decode an entry without holding the lock
+        mutable std::mutex mMutex;
+        std::condition_variable mPendingCondition;
+        std::condition_variable mDecodedCondition;
+        std::deque<Entry> mEntries;   // By `TaskID`
+        std::deque<TaskID> mPending;
+        double mDecodeMilliseconds = 0;
+        bool mIsStopping = false;
+
+        TaskID mFirstUnfinalized = 0;
+        double mFinalizeMilliseconds = 0;
+        std::vector<Phase> mPhases;
+        bool mIsReported = false;
+};
+
+
+#endif
@@ -1,7 +1,12 @@
 #ifndef MIXER_H
 #define MIXER_H
 
+#include <filesystem>
+#include <future>
+#include <optional>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <SDL.h>
 #include <SDL_mixer.h>
@@ -12,6 +17,8 @@
 
 /**
  * @brief Responsible for all operations related to music & sound effects.
+ * @note Sound effects are decoded to PCM once, upon construction, and mixed on a fixed pool of `config::mixer::SFXVoiceCount` voices; when every voice is busy, the least important i.e. lowest-priority then farthest one is stolen. Each effect is additionally rate-limited, so that the cost stays bounded however many entities emit it.
+ * @note BGM tracks stored uncompressed within `globals::archive` are streamed from the mapping in place. Others are read upon first use, or prefetched in the background, and kept in memory least-recently-used first out within `config::mixer::BGMCacheBudget`.
 */
 class Mixer final : Singleton<Mixer> {
     public:
@@ -29,6 +36,11 @@ class Mixer final : Singleton<Mixer> {
             kPlayerDeath,
         };
 
+        struct Stats {
+            std::size_t residentBGMBytes = 0;   // Encoded tracks copied into memory, excluding those streamed in place from the archive
+            std::size_t residentBGMCount = 0;
+        };
+
         INCL_SINGLETON(Mixer)
 
         Mixer();
@@ -42,67 +54,118 @@ class Mixer final : Singleton<Mixer> {
         void setBGMVolume(int volume) const;
         void setSFXVolume(int volume) const;
 
-        void playBGM(Mix_Music* BGM) const;
+        void playBGM(std::filesystem::path const& path);
         void stopBGM() const;
         void pauseBGM() const;
         void unpauseBGM() const;
 
-        void playSFX(SFXName SFX) const;
+        void playSFX(SFXName SFX);
+        void playSFXAt(SFXName SFX, SDL_Point const& sourceCoords);
         void stopSFX() const;
+        inline void setListenerCoords(SDL_Point const& coords) { mListenerCoords = coords; }
 
-        void onLevelChange(level::Name newLevel) const;
+        void onLevelChange(level::Name newLevel);
         void handleGameStateChange();
 
+        Stats getStats() const;
+
     private:
+        /**
+         * An encoded track held in memory, from which `Mix_Music` streams.
+        */
+        struct Track {
+            std::future<std::vector<char>> pendingData;   // Valid while being prefetched
+            std::vector<char> data;
+            std::size_t size = 0;
+            Mix_Music* music = nullptr;
+            unsigned long long lastUsed = 0;
+        };
+
+        /**
+         * A sound effect, decoded once into a PCM `Mix_Chunk` shared by every voice playing it.
+        */
+        struct SFXData {
+            std::filesystem::path path;
+            unsigned char priority;   // Higher-priority effects steal voices from lower-priority ones
+            unsigned int rateLimitTicks;   // Minimum interval between two plays, in `FrameClock::getTicks()` time
+            Mix_Chunk* chunk = nullptr;
+            std::optional<unsigned int> lastPlayedTicks;
+        };
+
+        /**
+         * The effect occupying a mixing channel, valid as long as the channel is playing.
+        */
+        struct Voice {
+            unsigned char priority = 0;
+            double distance = 0;
+            unsigned int startTicks = 0;
+        };
+
         void onGameStateChange(GameState const prev, GameState const next);
 
+        void emitSFX(SFXName SFX, double distance);
+        int allocateVoice(unsigned char priority, double distance) const;
+
+        Mix_Music* getBGM(std::filesystem::path const& path);
+        void prefetchBGM(std::filesystem::path const& path);
+        void evictBGM(std::string const& exemptKey);
+        void reportDeferredBGM() const;
+        static std::vector<char> readBGM(std::filesystem::path const& path);
+
+        std::vector<Voice> mVoices;   // By channel
+        SDL_Point mListenerCoords = { 0, 0 };
+
+        std::unordered_map<std::string, Track> mTracks;   // By path, since levels may share a track
+        std::string mCurrBGMPath;
+        unsigned long long mUseCount = 0;
+
         /**
          * @note Should not include in-game states, as those should be governed by `kLevelBGMMapping`.
         */
-        std::unordered_map<GameState, std::pair<Mix_Music*, std::filesystem::path>> kGameStateBGMMapping = {
-            { GameState::kMenu, std::make_pair(nullptr, config::path::asset_audio / "bgm/dearly-departed.mp3") },
-            { GameState::kGameOver, std::make_pair(nullptr, config::path::asset_audio / "bgm/caretaker-all-you-are-going-to-want-to-do-is-get-back-there.mp3") },
+        const std::unordered_map<GameState, std::filesystem::path> kGameStateBGMMapping = {
+            { GameState::kMenu, config::path::asset_audio / "bgm/dearly-departed.mp3" },
+            { GameState::kGameOver, config::path::asset_audio / "bgm/caretaker-all-you-are-going-to-want-to-do-is-get-back-there.mp3" },
         };
 
-        std::unordered_map<level::Name, std::pair<Mix_Music*, std::filesystem::path>> kLevelBGMMapping = {
-            { level::Name::kLevelPrologueMovement, std::make_pair(nullptr, config::path::asset_audio / "bgm/caretaker-late-afternoon-drifting.mp3") },
-            { level::Name::kLevelPrologueCombat, std::make_pair(nullptr, config::path::asset_audio / "bgm/caretaker-late-afternoon-drifting.mp3") },
-
-            { level::Name::kLevelSuffering_empty, std::make_pair(nullptr, config::path::asset_audio / "bgm/caretaker-lacunar-amnesia.mp3") },
-            { level::Name::kLevelSuffering_1_0, std::make_pair(nullptr, config::path::asset_audio / "bgm/caretaker-persistent-repetition-of-phrases.mp3") },
-            { level::Name::kLevelSuffering_1_1, std::make_pair(nullptr, config::path::asset_audio / "bgm/caretaker-von-restorff-effect.mp3") },
-            { level::Name::kLevelSuffering_2_0, std::make_pair(nullptr, config::path::asset_audio / "bgm/caretaker-false-memory-syndrome.mp3") },
-            { level::Name::kLevelSuffering_2_1, std::make_pair(nullptr, config::path::asset_audio / "bgm/caretaker-unmasking-alzheimers.mp3") },
-            { level::Name::kLevelSuffering_3_0, std::make_pair(nullptr, config::path::asset_audio / "bgm/caretaker-past-life-regression.mp3") },
-            { level::Name::kLevelSuffering_3_1, std::make_pair(nullptr, config::path::asset_audio / "bgm/caretaker-rosy-retrospection.mp3") },
-            { level::Name::kLevelSuffering_3_2, std::make_pair(nullptr, config::path::asset_audio / "bgm/caretaker-persistent-repetition-of-phrases.mp3") },
-
-            { level::Name::kLevelStatusQuo_0, std::make_pair(nullptr, config::path::asset_audio / "bgm/caretaker-all-you-are-going-to-want-to-do-is-get-back-there.mp3") },
-            { level::Name::kLevelStatusQuo_1, std::make_pair(nullptr, config::path::asset_audio / "bgm/caretaker-all-you-are-going-to-want-to-do-is-get-back-there.mp3") },
-            { level::Name::kLevelStatusQuo_2, std::make_pair(nullptr, config::path::asset_audio / "bgm/caretaker-all-you-are-going-to-want-to-do-is-get-back-there.mp3") },
-            { level::Name::kLevelStatusQuo_3, std::make_pair(nullptr, config::path::asset_audio / "bgm/caretaker-its-just-a-burning-memory.mp3") },
-            { level::Name::kLevelStatusQuo_4, std::make_pair(nullptr, config::path::asset_audio / "bgm/caretaker-everything-is-on-the-point-of-decline.mp3") },
-
-            { level::Name::kLevelRoundtable_empty, std::make_pair(nullptr, config::path::asset_audio / "bgm/caretaker-everything-is-on-the-point-of-decline.mp3") },
-            { level::Name::kLevelRoundtable_first, std::make_pair(nullptr, config::path::asset_audio / "bgm/caretaker-everything-is-on-the-point-of-decline.mp3") },
-            { level::Name::kLevelRoundtable_second, std::make_pair(nullptr, config::path::asset_audio / "bgm/caretaker-everything-is-on-the-point-of-decline.mp3") },
-            { level::Name::kLevelRoundtable_final, std::make_pair(nullptr, config::path::asset_audio / "bgm/caretaker-everything-is-on-the-point-of-decline.mp3") },
+        const std::unordered_map<level::Name, std::filesystem::path> kLevelBGMMapping = {
+            { level::Name::kLevelPrologueMovement, config::path::asset_audio / "bgm/caretaker-late-afternoon-drifting.mp3" },
+            { level::Name::kLevelPrologueCombat, config::path::asset_audio / "bgm/caretaker-late-afternoon-drifting.mp3" },
+
+            { level::Name::kLevelSuffering_empty, config::path::asset_audio / "bgm/caretaker-lacunar-amnesia.mp3" },
+            { level::Name::kLevelSuffering_1_0, config::path::asset_audio / "bgm/caretaker-persistent-repetition-of-phrases.mp3" },
+            { level::Name::kLevelSuffering_1_1, config::path::asset_audio / "bgm/caretaker-von-restorff-effect.mp3" },
+            { level::Name::kLevelSuffering_2_0, config::path::asset_audio / "bgm/caretaker-false-memory-syndrome.mp3" },
+            { level::Name::kLevelSuffering_2_1, config::path::asset_audio / "bgm/caretaker-unmasking-alzheimers.mp3" },
+            { level::Name::kLevelSuffering_3_0, config::path::asset_audio / "bgm/caretaker-past-life-regression.mp3" },
+            { level::Name::kLevelSuffering_3_1, config::path::asset_audio / "bgm/caretaker-rosy-retrospection.mp3" },
+            { level::Name::kLevelSuffering_3_2, config::path::asset_audio / "bgm/caretaker-persistent-repetition-of-phrases.mp3" },
+
+            { level::Name::kLevelStatusQuo_0, config::path::asset_audio / "bgm/caretaker-all-you-are-going-to-want-to-do-is-get-back-there.mp3" },
+            { level::Name::kLevelStatusQuo_1, config::path::asset_audio / "bgm/caretaker-all-you-are-going-to-want-to-do-is-get-back-there.mp3" },
+            { level::Name::kLevelStatusQuo_2, config::path::asset_audio / "bgm/caretaker-all-you-are-going-to-want-to-do-is-get-back-there.mp3" },
+            { level::Name::kLevelStatusQuo_3, config::path::asset_audio / "bgm/caretaker-its-just-a-burning-memory.mp3" },
+            { level::Name::kLevelStatusQuo_4, config::path::asset_audio / "bgm/caretaker-everything-is-on-the-point-of-decline.mp3" },
+
+            { level::Name::kLevelRoundtable_empty, config::path::asset_audio / "bgm/caretaker-everything-is-on-the-point-of-decline.mp3" },
+            { level::Name::kLevelRoundtable_first, config::path::asset_audio / "bgm/caretaker-everything-is-on-the-point-of-decline.mp3" },
+            { level::Name::kLevelRoundtable_second, config::path::asset_audio / "bgm/caretaker-everything-is-on-the-point-of-decline.mp3" },
+            { level::Name::kLevelRoundtable_final, config::path::asset_audio / "bgm/caretaker-everything-is-on-the-point-of-decline.mp3" },
             
-            { level::Name::kLevelWhiteSpace, std::make_pair(nullptr, config::path::asset_audio / "bgm/omori-002-white-space.mp3") },
+            { level::Name::kLevelWhiteSpace, config::path::asset_audio / "bgm/omori-002-white-space.mp3" },
         };
 
-        std::unordered_map<SFXName, std::pair<Mix_Chunk*, std::filesystem::path>> kSFXMapping = {
-            { SFXName::kDialogue, std::make_pair(nullptr, config::path::asset_audio / "sfx/omori-talking.mp3") },
-            { SFXName::kMewo, std::make_pair(nullptr, config::path::asset_audio / "sfx/omori-mewo.mp3") },
-            { SFXName::kButtonClick, std::make_pair(nullptr, config::path::asset_audio / "sfx/一般の警告音.mp3") },
-            { SFXName::kSurgeAttack, std::make_pair(nullptr, config::path::asset_audio / "sfx/omori-beep.mp3") },
-            { SFXName::kPlayerWalk, std::make_pair(nullptr, config::path::asset_audio / "sfx/zapsplat-foley-footstep-single-wet-ground-light-puddles.mp3") },
-            { SFXName::kPlayerRun, std::make_pair(nullptr, config::path::asset_audio / "sfx/zapsplat-foley-footstep-single-boot-heavy-clump-step-gravel.mp3") },            
-            { SFXName::kPlayerAttack, std::make_pair(nullptr, config::path::asset_audio / "sfx/omori-omori-attack.mp3") },
-            { SFXName::kEntityAttack, std::make_pair(nullptr, config::path::asset_audio / "sfx/omori-swish.mp3") },
-            { SFXName::kEntityDamaged, std::make_pair(nullptr, config::path::asset_audio / "sfx/omori-bite.mp3") },
-            { SFXName::kEntityDeath, std::make_pair(nullptr, config::path::asset_audio / "sfx/wilhelm-scream.mp3") },
-            { SFXName::kPlayerDeath, std::make_pair(nullptr, config::path::asset_audio / "sfx/omori-death-by-experiment-667.mp3") },
+        std::unordered_map<SFXName, SFXData> kSFXMapping = {
+            { SFXName::kDialogue, { config::path::asset_audio / "sfx/omori-talking.mp3", 3, 0 } },
+            { SFXName::kMewo, { config::path::asset_audio / "sfx/omori-mewo.mp3", 2, 0 } },
+            { SFXName::kButtonClick, { config::path::asset_audio / "sfx/一般の警告音.mp3", 3, 0 } },
+            { SFXName::kSurgeAttack, { config::path::asset_audio / "sfx/omori-beep.mp3", 1, 50 } },
+            { SFXName::kPlayerWalk, { config::path::asset_audio / "sfx/zapsplat-foley-footstep-single-wet-ground-light-puddles.mp3", 1, 0 } },
+            { SFXName::kPlayerRun, { config::path::asset_audio / "sfx/zapsplat-foley-footstep-single-boot-heavy-clump-step-gravel.mp3", 1, 0 } },            
+            { SFXName::kPlayerAttack, { config::path::asset_audio / "sfx/omori-omori-attack.mp3", 2, 0 } },
+            { SFXName::kEntityAttack, { config::path::asset_audio / "sfx/omori-swish.mp3", 0, 80 } },
+            { SFXName::kEntityDamaged, { config::path::asset_audio / "sfx/omori-bite.mp3", 1, 60 } },
+            { SFXName::kEntityDeath, { config::path::asset_audio / "sfx/wilhelm-scream.mp3", 1, 100 } },
+            { SFXName::kPlayerDeath, { config::path::asset_audio / "sfx/omori-death-by-experiment-667.mp3", 3, 0 } },
         };
 };
 
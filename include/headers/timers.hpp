@@ -1,12 +1,51 @@
 #ifndef TIMER_H
 #define TIMER_H
 
+#include <array>
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
 #include <SDL_timer.h>
 
 #include <meta.hpp>
 #include <auxiliaries.hpp>
 
 
+/* Clocks */
+
+/**
+ * @brief The time source shared by every timer. Sampled exactly once per frame in `<game.h> Game::startGameLoop()`, then consumed in fixed simulation ticks of `1 / config::game::TPS` seconds.
+ * @note Timers read the simulation time, which only moves in whole ticks i.e. their outcome does not depend on the render rate. Real time is backed by `SDL_GetPerformanceCounter()` for sub-millisecond resolution.
+ * @note `getTicks()` truncates to milliseconds, matching the granularity previously returned by `SDL_GetTicks()`.
+ * @see https://gafferongames.com/post/fix_your_timestep/
+*/
+class FrameClock final {
+    public:
+        static void tick();
+        static bool step();
+        static double now();
+
+        static inline unsigned int getTicks() { return static_cast<unsigned int>(sTickCount * 1000 / config::game::TPS); }
+        static inline unsigned long long int getTickCount() { return sTickCount; }
+        static inline double getMilliseconds() { return sFrameMilliseconds; }
+        static inline double getDeltaMilliseconds() { return sDeltaMilliseconds; }
+        static inline double getInterpolation() { return sAccumulatedMilliseconds / kMillisecondsPerTick; }
+
+    private:
+        static constexpr double kMillisecondsPerTick = 1000.0 / config::game::TPS;
+
+        static Uint64 sBaseCounter;
+        static double sMillisecondsPerCount;
+
+        static double sFrameMilliseconds;
+        static double sDeltaMilliseconds;
+
+        static double sAccumulatedMilliseconds;   // Real time not yet consumed by simulation ticks
+        static unsigned long long int sTickCount;
+};
+
+
 /* Abstract templates */
 
 /**
@@ -59,18 +98,42 @@ class FPSDisplayTimer final : public Singleton<FPSDisplayTimer>, public GenericT
 
 /**
  * @brief Represent a timer tailored for capping in-game FPS.
+ * @note Frames are paced against absolute deadlines `1 / config::game::FPS` seconds apart, so that rounding never accumulates. Waiting is a coarse `SDL_Delay()` followed by a short spin, whose margin adapts to the observed oversleep of the scheduler.
+ * @note If the renderer presents with VSync, `SDL_RenderPresent()` already blocks until the next refresh; the timer then only records, treating a skipped refresh as a missed deadline.
 */
-class FPSControlTimer final : public Singleton<FPSControlTimer>, public GenericTimer {
+class FPSControlTimer final : public Singleton<FPSControlTimer> {
     public:
         INCL_SINGLETON(FPSControlTimer)
         
-        FPSControlTimer() = default;
+        FPSControlTimer();
         ~FPSControlTimer() = default;
 
         void controlFPS();
 
+        double getAverageFrameMilliseconds() const;
+        double getMaxFrameMilliseconds() const;
+        inline unsigned long long int getMissedDeadlineCount() const { return mMissedDeadlineCount; }
+        inline bool isVSyncPaced() const { return mIsVSyncPaced; }
+
     private:
-        static constexpr unsigned int kTicksPerFrame = 1000 / config::game::FPS;
+        void wait(double deadline);
+        void record(double frameMilliseconds);
+
+        static constexpr double kMillisecondsPerFrame = 1000.0 / config::game::FPS;
+        static constexpr double kMinSpinMilliseconds = 0.25;
+        static constexpr double kMaxSpinMilliseconds = 4;
+
+        bool mIsVSyncPaced = false;
+        double mRefreshMilliseconds = kMillisecondsPerFrame;
+
+        double mDeadline;   // In `FrameClock::now()` time
+        double mPrevFrameEnd;
+        double mSpinMilliseconds = 1;
+
+        std::array<double, config::game::frameHistorySize> mFrameHistory{};   // Ring buffer of the latest frame durations, in milliseconds
+        std::size_t mFrameHistoryIndex = 0;
+        std::size_t mFrameHistoryCount = 0;
+        unsigned long long int mMissedDeadlineCount = 0;
 };
 
 class CountdownTimer final : public GenericTimer {
@@ -79,6 +142,7 @@ class CountdownTimer final : public GenericTimer {
         ~CountdownTimer() = default;
 
         inline bool isFinished() const { return getTicks() >= mMaxTicks; }
+        inline unsigned int getMaxTicks() const { return mMaxTicks; }
         inline void setMaxTicks(unsigned int maxTicks) { mMaxTicks = maxTicks; }
 
     private:
@@ -86,4 +150,56 @@ class CountdownTimer final : public GenericTimer {
 };
 
 
+/**
+ * @brief A hierarchical timer wheel. Fires due callbacks on `advance()` instead of having every owner poll its own timer.
+ * @note Four levels of 64 slots with millisecond resolution i.e. deadlines up to ~4.6 hours ahead are placed exactly; further deadlines are parked in the outermost level and re-cascaded. Scheduling, cancellation and per-tick work are O(1) regardless of the number of pending timers.
+ * @note Callbacks due in the same `advance()` are fired after the wheel has caught up with `FrameClock`, in deadline order. A callback scheduled from within another callback is never fired in the same `advance()`, even if its delay is zero.
+ * @see https://www.cs.columbia.edu/~nahum/w6998/papers/sosp87-timing-wheels.pdf
+*/
+class TimerWheel final : public Singleton<TimerWheel> {
+    public:
+        INCL_SINGLETON(TimerWheel)
+
+        using Handle = unsigned long long int;
+        using Callback = std::function<void()>;
+
+        static constexpr Handle kInvalidHandle = 0;
+
+        TimerWheel();
+        ~TimerWheel() = default;
+
+        Handle schedule(unsigned int delayTicks, Callback const& callback);
+        void cancel(Handle handle);
+        void advance();
+        void clear();
+
+        inline bool isScheduled(Handle handle) const { return mActiveHandles.find(handle) != mActiveHandles.end(); }
+        inline std::size_t size() const { return mActiveHandles.size(); }
+
+    private:
+        struct Timer {
+            Handle handle;
+            unsigned int deadline;
+            Callback callback;
+        };
+
+        void insert(Timer&& timer);
+        void cascade(int level);
+
+        static constexpr int kLevelCount = 4;
+        static constexpr int kSlotBits = 6;
+        static constexpr unsigned int kSlotCount = 1u << kSlotBits;
+        static constexpr unsigned int kSlotMask = kSlotCount - 1;
+        static constexpr unsigned int kMaxDelta = (1u << (kSlotBits * kLevelCount)) - 1;
+
+        std::array<std::array<std::vector<Timer>, kSlotCount>, kLevelCount> mSlots;
+        std::vector<Timer> mOverdue;   // Already due when scheduled, fired on the next `advance()`
+        std::vector<Timer> mDue;   // Reused across `advance()` calls
+
+        std::unordered_set<Handle> mActiveHandles;   // Cancelled timers are dropped lazily when their slot is reached
+        Handle mNextHandle = kInvalidHandle + 1;
+        unsigned int mCurrTicks;   // The last tick processed by the wheel
+};
+
+
 #endif
\ No newline at end of file
@@ -0,0 +1,298 @@
+#include <auxiliaries.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN64) || defined(_WIN32)
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include <SDL.h>
+#include <zlib/zlib.h>
+
+
+AssetArchive::~AssetArchive() {
+    unmount();
+}
+
+/**
+ * @brief Map the archive at `archivePath` into memory, replacing any previously mounted one.
+ * @return `false` if the archive is missing or malformed, in which case every asset is read from loose files.
+*/
+bool AssetArchive::mount(std::filesystem::path const& archivePath) {
+    static_assert(sizeof(Header) == 24 && sizeof(Record) == 32, "`Header` and `Record` are read as is");
+    unmount();
+
+    void* base;
+    std::size_t size;
+
+#if defined(_WIN64) || defined(_WIN32)
+    HANDLE file = CreateFileW(archivePath.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0 ? CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    CloseHandle(file);
+    if (mapping == nullptr) return false;
+
+    base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);   // The view keeps the mapping alive
+    if (base == nullptr) return false;
+    size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    int file = ::open(archivePath.c_str(), O_RDONLY);
+    if (file == -1) return false;
+
+    struct stat status;
+    base = fstat(file, &status) == 0 && status.st_size > 0 ? mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0) : MAP_FAILED;
+    ::close(file);   // The mapping outlives the descriptor
+    if (base == MAP_FAILED) return false;
+    size = static_cast<std::size_t>(status.st_size);
+#endif
+
+    mBase = static_cast<unsigned char const*>(base);
+    mSize = size;
+
+    // Validate everything up front, so that lookups need not
+    Header header;
+    if (mSize < sizeof(header)) {
+        unmount();
+        return false;
+    }
+    std::memcpy(&header, mBase, sizeof(header));
+
+    if (header.magic != kMagic || header.version != kVersion || header.indexOffset > mSize || header.entryCount > (mSize - header.indexOffset) / sizeof(Record)) {
+        unmount();
+        return false;
+    }
+
+    auto records = mBase + header.indexOffset;
+    auto paths = records + header.entryCount * sizeof(Record);
+    auto pathsSize = static_cast<std::size_t>(mBase + mSize - paths);
+
+    mEntries.resize(header.entryCount);
+    for (std::size_t i = 0; i < mEntries.size(); ++i) {
+        auto& entry = mEntries[i];
+        auto& record = entry.record;
+        std::memcpy(&record, records + i * sizeof(Record), sizeof(Record));   // Records are not necessarily aligned within the mapping
+
+        if (record.offset > mSize || record.storedSize > mSize - record.offset || record.pathOffset > pathsSize || record.pathSize > pathsSize - record.pathOffset || record.compression > Compression::kZlib || (record.compression == Compression::kNone && record.storedSize != record.size)) {
+            unmount();
+            return false;
+        }
+
+        entry.path = std::string_view(reinterpret_cast<char const*>(paths + record.pathOffset), record.pathSize);
+    }
+
+    if (!std::is_sorted(mEntries.begin(), mEntries.end(), [](Entry const& first, Entry const& second) { return first.path < second.path; })) {
+        unmount();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @note `SDL_RWops` opened on archived entries must not be used afterwards.
+*/
+void AssetArchive::unmount() {
+    if (mBase != nullptr) {
+#if defined(_WIN64) || defined(_WIN32)
+        UnmapViewOfFile(mBase);
+#else
+        munmap(const_cast<unsigned char*>(mBase), mSize);
+#endif
+    }
+
+    mBase = nullptr;
+    mSize = 0;
+    mEntries.clear();
+}
+
+bool AssetArchive::exists(std::filesystem::path const& path) const {
+    std::error_code error;
+    return find(path) != nullptr || std::filesystem::is_regular_file(path, error);
+}
+
+/**
+ * @return `true` if the asset at `path` is stored uncompressed within the archive, in which case `open()` reads it in place.
+*/
+bool AssetArchive::isMapped(std::filesystem::path const& path) const {
+    auto entry = resolve(path);
+    return entry != nullptr && entry->record.compression == Compression::kNone;
+}
+
+/**
+ * @return the size of the asset at `path` once read e.g. inflated, or `std::nullopt` if there is no such asset.
+*/
+std::optional<std::size_t> AssetArchive::getSize(std::filesystem::path const& path) const {
+    auto entry = resolve(path);
+    if (entry != nullptr) return static_cast<std::size_t>(entry->record.size);
+
+    std::error_code error;
+    auto size = std::filesystem::file_size(path, error);
+    if (error) return std::nullopt;
+    return static_cast<std::size_t>(size);
+}
+
+/**
+ * @brief Open the asset at `path` for reading, e.g. by `IMG_Load_RW()`.
+ * @return `nullptr` on failure. Otherwise, should be closed by the caller, or by passing `freesrc = 1`.
+ * @note Stored entries are read in place, hence cost neither a syscall nor a copy. Deflated entries are inflated into a buffer released along with the `SDL_RWops`.
+*/
+SDL_RWops* AssetArchive::open(std::filesystem::path const& path) const {
+    auto entry = resolve(path);
+    if (entry == nullptr) return SDL_RWFromFile(path.string().c_str(), "rb");
+
+    auto const& record = entry->record;
+    if (record.compression == Compression::kNone) return SDL_RWFromConstMem(mBase + record.offset, static_cast<int>(record.size));
+
+    auto buffer = SDL_malloc(static_cast<std::size_t>(record.size));
+    auto context = buffer != nullptr && inflate(*entry, buffer) ? SDL_RWFromConstMem(buffer, static_cast<int>(record.size)) : nullptr;
+    if (context == nullptr) {
+        SDL_free(buffer);
+        return nullptr;
+    }
+
+    context->close = [](SDL_RWops* context) -> int {
+        SDL_free(context->hidden.mem.base);
+        SDL_FreeRW(context);
+        return 0;
+    };
+    return context;
+}
+
+/**
+ * @brief Copy the whole asset at `path` into `data`, e.g. for JSON and XML parsers that require a contiguous buffer.
+*/
+bool AssetArchive::read(std::filesystem::path const& path, std::vector<char>& data) const {
+    auto entry = resolve(path);
+
+    if (entry == nullptr) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) return false;
+
+        data.resize(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        return static_cast<bool>(file.read(data.data(), data.size()));
+    }
+
+    auto const& record = entry->record;
+    data.resize(static_cast<std::size_t>(record.size));
+    if (record.compression == Compression::kZlib) return inflate(*entry, data.data());
+
+    std::memcpy(data.data(), mBase + record.offset, data.size());
+    return true;
+}
+
+/**
+ * @brief Pack every file under `directory` into a new archive at `archivePath`, deflating those that shrink.
+ * @note The archive is written next to `archivePath`, then renamed over it, so that a mounted archive is never observed half-written.
+*/
+bool AssetArchive::pack(std::filesystem::path const& directory, std::filesystem::path const& archivePath) {
+    std::error_code error;
+    std::vector<std::pair<std::string, std::filesystem::path>> files;
+    for (auto it = std::filesystem::recursive_directory_iterator(directory, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+        if (it->is_regular_file(error)) files.emplace_back(getKey(it->path()), it->path());
+    }
+    if (error) return false;
+    std::sort(files.begin(), files.end());
+
+    auto temporaryPath = archivePath;
+    temporaryPath += ".tmp";
+    std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    file.seekp(sizeof(Header));
+
+    std::vector<Record> records;
+    std::string paths;
+    std::vector<char> data;
+    std::vector<Bytef> deflated;
+    AssetArchive loose;   // Unmounted, hence reads loose files only
+
+    for (auto const& [key, path] : files) {
+        if (key.size() > std::numeric_limits<Uint16>::max() || !loose.read(path, data)) return false;
+
+        Record record = { static_cast<Uint64>(file.tellp()), data.size(), data.size(), static_cast<Uint32>(paths.size()), static_cast<Uint16>(key.size()), Compression::kNone, 0 };
+
+        // Mostly benefits text e.g. Tiled JSON and XML; PNG, MP3 and the like are already compressed
+        auto deflatedSize = compressBound(static_cast<uLong>(data.size()));
+        deflated.resize(deflatedSize);
+        if (compress2(deflated.data(), &deflatedSize, reinterpret_cast<Bytef const*>(data.data()), static_cast<uLong>(data.size()), Z_BEST_COMPRESSION) == Z_OK && deflatedSize < data.size()) {
+            record.storedSize = deflatedSize;
+            record.compression = Compression::kZlib;
+            file.write(reinterpret_cast<char const*>(deflated.data()), deflatedSize);
+        } else {
+            file.write(data.data(), data.size());
+        }
+
+        records.push_back(record);
+        paths += key;
+    }
+
+    Header header = { kMagic, kVersion, records.size(), static_cast<Uint64>(file.tellp()) };
+    file.write(reinterpret_cast<char const*>(records.data()), records.size() * sizeof(Record));
+    file.write(paths.data(), paths.size());
+    file.seekp(0);
+    file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    file.close();
+    if (!file) return false;
+
+    std::filesystem::rename(temporaryPath, archivePath, error);
+    return !error;
+}
+
+/**
+ * @brief Convert `path` to the form it is indexed by, regardless of platform.
+*/
+std::string AssetArchive::getKey(std::filesystem::path const& path) {
+    auto key = path.generic_string();
+    while (key.rfind("./", 0) == 0) key.erase(0, 2);
+    return key;
+}
+
+/**
+ * @brief Binary search the index for `path`.
+*/
+AssetArchive::Entry const* AssetArchive::find(std::filesystem::path const& path) const {
+    if (mEntries.empty()) return nullptr;
+
+    auto key = getKey(path);
+    auto it = std::lower_bound(mEntries.begin(), mEntries.end(), key, [](Entry const& entry, std::string const& key) { return entry.path < key; });
+    return it != mEntries.end() && it->path == key ? &*it : nullptr;
+}
+
+/**
+ * @return the archived entry to read `path` from, or `nullptr` if it should be read from a loose file instead.
+*/
+AssetArchive::Entry const* AssetArchive::resolve(std::filesystem::path const& path) const {
+    if (mEntries.empty()) return nullptr;
+
+    if constexpr(config::enable_loose_assets) {
+        std::error_code error;
+        if (std::filesystem::is_regular_file(path, error)) return nullptr;
+    }
+
+    return find(path);
+}
+
+/**
+ * @note `dest` must hold `entry.record.size` bytes.
+*/
+bool AssetArchive::inflate(Entry const& entry, void* dest) const {
+    auto size = static_cast<uLongf>(entry.record.size);
+    return uncompress(static_cast<Bytef*>(dest), &size, mBase + entry.record.offset, static_cast<uLong>(entry.record.storedSize)) == Z_OK && size == entry.record.size;
+}
@@ -32,12 +32,6 @@ void event::terminate(SDL_Event const& event) {
             break;
 
         case event::Code::kReq_AttackRegister_Player_GHE:
-        case event::Code::kReq_AttackRegister_GHE_Player:
-        case event::Code::kReq_AttackInitiate_GHE_Player:
-        case event::Code::kReq_MoveInitiate_GHE_Player:
-        case event::Code::kResp_AttackInitiate_GHE_Player:
-        case event::Code::kResp_MoveInitiate_GHE_Player:
-        case event::Code::kResp_MoveTerminate_GHE_Player:
             event::__deallocate__<event::Data_Generic>(event);
             break;
 
@@ -0,0 +1,133 @@
+#include <auxiliaries.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#if defined(_WIN64) || defined(_WIN32)
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+
+/**
+ * @note Writes still pending are committed before returning.
+*/
+FileWriter::~FileWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsStopping = true;
+    }
+    mPendingCondition.notify_all();
+
+    if (mWorker.joinable()) mWorker.join();
+}
+
+/**
+ * @brief Queue `encode()` to be run on the worker, then its result to be committed to `path`.
+ * @note The worker is started on the first call rather than upon construction.
+*/
+void FileWriter::submit(std::filesystem::path const& path, std::function<std::string(void)> const& encode) {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        auto it = std::find_if(mPending.begin(), mPending.end(), [&](Job const& job) { return job.path == path; });
+        if (it != mPending.end()) it->encode = encode;   // Superseded
+        else mPending.push_back({ path, encode });
+    }
+    mPendingCondition.notify_one();
+
+    if (!mWorker.joinable()) mWorker = std::thread(&FileWriter::work, this);
+}
+
+/**
+ * @brief Block until every submitted write is committed, e.g. before reading a file back or exiting.
+*/
+void FileWriter::flush() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mIdleCondition.wait(lock, [&]() { return mPending.empty() && !mIsWriting; });
+}
+
+/**
+ * @brief Write `data` to `path` atomically, on the calling thread.
+ * @return `false` on failure, in which case `path` is left as is.
+*/
+bool FileWriter::commit(std::filesystem::path const& path, std::string const& data) {
+    std::error_code error;
+    if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), error);
+
+    auto temporaryPath = path;
+    temporaryPath += ".tmp";
+
+#if defined(_WIN64) || defined(_WIN32)
+    HANDLE file = CreateFileW(temporaryPath.wstring().c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    DWORD writtenSize = 0;
+    bool isWritten = WriteFile(file, data.data(), static_cast<DWORD>(data.size()), &writtenSize, nullptr) && writtenSize == data.size() && FlushFileBuffers(file);
+    CloseHandle(file);
+
+    if (!isWritten || !MoveFileExW(temporaryPath.wstring().c_str(), path.wstring().c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        DeleteFileW(temporaryPath.wstring().c_str());
+        return false;
+    }
+#else
+    int file = ::open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (file == -1) return false;
+
+    bool isWritten = true;
+    for (std::size_t offset = 0; isWritten && offset < data.size();) {
+        auto writtenSize = ::write(file, data.data() + offset, data.size() - offset);
+        if (writtenSize < 0 && errno == EINTR) continue;
+        isWritten = writtenSize > 0;
+        if (isWritten) offset += static_cast<std::size_t>(writtenSize);
+    }
+    isWritten = isWritten && fsync(file) == 0;   // Otherwise the rename might reach the disk before the data does
+    isWritten = ::close(file) == 0 && isWritten;
+
+    if (!isWritten || std::rename(temporaryPath.c_str(), path.c_str())) {
+        ::unlink(temporaryPath.c_str());
+        return false;
+    }
+
+    // Persist the rename itself
+    int directory = ::open(path.has_parent_path() ? path.parent_path().c_str() : ".", O_RDONLY);
+    if (directory != -1) {
+        fsync(directory);
+        ::close(directory);
+    }
+#endif
+
+    return true;
+}
+
+void FileWriter::work() {
+    while (true) {
+        Job job;
+
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mPendingCondition.wait(lock, [&]() { return mIsStopping || !mPending.empty(); });
+            if (mPending.empty()) return;   // Stopping, with nothing left to write
+
+            job = std::move(mPending.front());
+            mPending.pop_front();
+            mIsWriting = true;
+        }
+
+        commit(job.path, job.encode());
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mIsWriting = false;
+        }
+        mIdleCondition.notify_all();
+    }
+}
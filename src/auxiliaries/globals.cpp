@@ -9,6 +9,8 @@ SDL_Point globals::windowSize;
 SDL_Point globals::mouseState;
 GameState globals::state = GameState::kMenu;
 GarbageCollector globals::gc;
+SpriteBatcher globals::batcher;
+AssetArchive globals::archive;
 
 
 /**
@@ -16,6 +18,8 @@ GarbageCollector globals::gc;
  * @note Should be called when the program terminates.
 */
 void globals::deinitialize() {
+    globals::batcher.clear();
+
     if (globals::renderer != nullptr) {
         SDL_DestroyRenderer(globals::renderer);
         globals::renderer = nullptr;
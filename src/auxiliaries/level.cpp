@@ -258,6 +258,11 @@ void level::Data::load(json const& JSONLevelData) {
     loadProperties(JSONLevelData);
     loadLayers(JSONLevelData);
     loadTilelayerTilesets(JSONLevelData);
+
+    pathfinders::flowfields.clear();   // Invalidate fields built over the previous `collisionTilelayer`
+    pathfinders::components.build();   // Must precede `hierarchy` which consults it during searches
+    pathfinders::hierarchy.build();
+    pathfinders::service.synchronize();
 }
 
 void level::Data::loadProperties(json const& JSONLevelData) {
@@ -420,4 +425,8 @@ void level::Data::clear() {
 }
 
 
-level::Data level::data;
\ No newline at end of file
+level::Data level::data;
+pathfinders::FlowFieldCache pathfinders::flowfields(level::data.collisionTilelayer, config::entities::FlowFieldCacheSize);   // Defined after `level::data` in the same translation unit to guarantee initialization order
+pathfinders::Components pathfinders::components(level::data.collisionTilelayer);
+pathfinders::HPAPF pathfinders::hierarchy(level::data.collisionTilelayer, config::entities::HPAClusterSize, &pathfinders::components);
+pathfinders::PathService pathfinders::service(level::data.collisionTilelayer, config::entities::PathServiceWorkerCount, &pathfinders::components);
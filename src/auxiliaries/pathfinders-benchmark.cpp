@@ -0,0 +1,146 @@
+#include <auxiliaries.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+
+namespace pathfinders {
+    namespace {
+        using Grid = std::vector<std::vector<int>>;
+        using Query = std::pair<Cell, Cell>;
+
+        constexpr int kGridSize = 256;
+        constexpr int kQueryCount = 300;
+
+        /**
+         * @brief Generate a grid of `kGridSize` cells per side, of which roughly `blockedPercentage` are blocked.
+        */
+        Grid generateField(unsigned int blockedPercentage, std::mt19937& engine) {
+            Grid grid(kGridSize, std::vector<int>(kGridSize, 1));
+            for (auto& row : grid) for (auto& value : row) if (engine() % 100 < blockedPercentage) value = 0;
+            return grid;
+        }
+
+        /**
+         * @brief Generate a perfect maze via a randomized depth-first search, with corridors on odd cells.
+        */
+        Grid generateMaze(std::mt19937& engine) {
+            static constexpr Cell kSteps[] = { { 2, 0 }, { -2, 0 }, { 0, 2 }, { 0, -2 } };
+
+            Grid grid(kGridSize, std::vector<int>(kGridSize, 0));
+            std::vector<Cell> stack = { { 1, 1 } };
+            grid[1][1] = 1;
+
+            while (!stack.empty()) {
+                auto cell = stack.back();
+                std::vector<Cell> candidates;
+                for (auto const& step : kSteps) {
+                    Cell next = { cell.x + step.x, cell.y + step.y };
+                    if (next.x > 0 && next.y > 0 && next.x < kGridSize - 1 && next.y < kGridSize - 1 && !grid[next.y][next.x]) candidates.push_back(next);
+                }
+
+                if (candidates.empty()) {
+                    stack.pop_back();
+                    continue;
+                }
+
+                auto next = candidates[engine() % candidates.size()];
+                grid[(cell.y + next.y) / 2][(cell.x + next.x) / 2] = 1;
+                grid[next.y][next.x] = 1;
+                stack.push_back(next);
+            }
+
+            return grid;
+        }
+
+        /**
+         * @brief Draw `kQueryCount` pairs of unblocked cells, identical across runs on the same grid.
+        */
+        std::vector<Query> generateQueries(Grid const& grid) {
+            std::mt19937 engine(kQueryCount);
+            std::vector<Query> queries;
+
+            while (queries.size() < kQueryCount) {
+                Cell src = { static_cast<int>(engine() % kGridSize), static_cast<int>(engine() % kGridSize) };
+                Cell dest = { static_cast<int>(engine() % kGridSize), static_cast<int>(engine() % kGridSize) };
+                if (grid[src.y][src.x] && grid[dest.y][dest.x] && !(src == dest)) queries.emplace_back(src, dest);
+            }
+
+            return queries;
+        }
+
+        struct Result {
+            double milliseconds = 0;
+            unsigned long long int expandedCount = 0;
+            std::size_t successCount = 0;
+        };
+
+        /**
+         * @brief Run every query through a fresh `PF` over `grid`.
+        */
+        template <typename PF>
+        Result run(Grid const& grid, std::vector<Query> const& queries) {
+            PF pathfinder(grid);
+            std::vector<Cell> path;
+            Result result;
+
+            auto begin = std::chrono::steady_clock::now();
+            for (auto const& [src, dest] : queries) {
+                if (pathfinder.search(src, dest, path) == Status::kSuccess) ++result.successCount;
+                result.expandedCount += pathfinder.getExpandedCount();
+            }
+            result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+            return result;
+        }
+
+        void print(char const* grid, char const* pathfinder, Result const& result) {
+            std::printf("%-8s %-10s %10.1f ms %12llu expanded %6zu found\n", grid, pathfinder, result.milliseconds, result.expandedCount, result.successCount);
+        }
+
+        /**
+         * @brief Compare `ASPF`, `JPSPF` and `JPSPlusPF` under 8-directional movement, where all three yield equal-cost paths.
+        */
+        void compareSearches(char const* name, Grid const& grid) {
+            auto queries = generateQueries(grid);
+            print(name, "A*", run<ASPF<Heuristic::kOctile, MovementType::k8Directional>>(grid, queries));
+            print(name, "JPS", run<JPSPF<>>(grid, queries));
+            print(name, "JPS+", run<JPSPlusPF<>>(grid, queries));
+        }
+
+        /**
+         * @brief Compare the `OpenListPolicy` of `ASPF` under both movement types.
+        */
+        void compareOpenLists(char const* name, Grid const& grid) {
+            auto queries = generateQueries(grid);
+            print(name, "4-binary", run<ASPF<Heuristic::kManhattan, MovementType::k4Directional, OpenListPolicy::kBinaryHeap>>(grid, queries));
+            print(name, "4-indexed", run<ASPF<Heuristic::kManhattan, MovementType::k4Directional, OpenListPolicy::kIndexedHeap>>(grid, queries));
+            print(name, "8-binary", run<ASPF<Heuristic::kOctile, MovementType::k8Directional, OpenListPolicy::kBinaryHeap>>(grid, queries));
+            print(name, "8-indexed", run<ASPF<Heuristic::kOctile, MovementType::k8Directional, OpenListPolicy::kIndexedHeap>>(grid, queries));
+        }
+    }
+}
+
+/**
+ * @brief Print the wall time and the number of expanded cells of each pathfinder, then of each open-list policy, over the same random queries on open fields, sparse fields and mazes.
+ * @note Invoked via the `--benchmark` command-line argument. Results are only comparable across builds with the same flags, e.g. `make release=1`.
+*/
+void pathfinders::benchmark() {
+    std::mt19937 engine(kGridSize);
+    auto openField = generateField(0, engine);
+    auto sparseField = generateField(20, engine);
+    auto maze = generateMaze(engine);
+
+    std::printf("%d queries on %dx%d grids\n", kQueryCount, kGridSize, kGridSize);
+    compareSearches("open", openField);
+    compareSearches("sparse", sparseField);
+    compareSearches("maze", maze);
+
+    std::printf("\n");
+    compareOpenLists("open", openField);
+    compareOpenLists("sparse", sparseField);
+    compareOpenLists("maze", maze);
+}
@@ -1,11 +1,11 @@
 #include <auxiliaries.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <functional>
 #include <limits>
 #include <vector>
-#include <stack>
 
 
 double pathfinders::Cell::getG(Cell const& cell) {
@@ -46,7 +46,8 @@ pathfinders::Cell::getH(Cell const& cell, Cell const& dest) {
 
 template <typename T, typename Compare>
 void pathfinders::OpenList<T, Compare>::push(T const& element) {
-    mHeap.push(element);   // O(log(n))
+    mHeap.push_back(element);
+    std::push_heap(mHeap.begin(), mHeap.end(), Compare{});   // O(log(n))
 }
 
 template <typename T, typename Compare>
@@ -58,141 +59,1679 @@ T pathfinders::OpenList<T, Compare>::pop() {
 
 template <typename T, typename Compare>
 T const& pathfinders::OpenList<T, Compare>::getRoot() const {
-    return mHeap.top();   // O(1)
+    return mHeap.front();   // O(1)
 }
 
 template <typename T, typename Compare>
 void pathfinders::OpenList<T, Compare>::eraseRoot() {
     if (mHeap.empty()) return;
-    mHeap.pop();   // O(log(n))
+    std::pop_heap(mHeap.begin(), mHeap.end(), Compare{});   // O(log(n))
+    mHeap.pop_back();
 }
 
-template <pathfinders::Heuristic H, pathfinders::MovementType M>
-pathfinders::ASPF<H, M>::ASPF(std::vector<std::vector<int>> const& grid) : mGrid(grid) {
+/**
+ * @brief Insert `element` under `index`, or, if `index` is already present, replace its element should `element` take precedence.
+ * @note O(log_D(n)) either way.
+*/
+template <typename T, std::size_t D, typename Compare>
+void pathfinders::IndexedOpenList<T, D, Compare>::push(std::size_t index, T const& element) {
+    auto position = mPositions[index];
+
+    if (position == kAbsent) {
+        mHeap.emplace_back(index, element);
+        siftUp(mHeap.size() - 1);
+    } else if (Compare{}(mHeap[position].second, element)) {
+        mHeap[position].second = element;   // Decrease-key
+        siftUp(position);
+    }
+}
+
+template <typename T, std::size_t D, typename Compare>
+T pathfinders::IndexedOpenList<T, D, Compare>::pop() {
+    auto root = std::move(mHeap.front());
+    mPositions[root.first] = kAbsent;
+
+    if (mHeap.size() > 1) {
+        mHeap.front() = std::move(mHeap.back());
+        mHeap.pop_back();
+        siftDown(0);
+    } else mHeap.pop_back();
+
+    return root.second;
+}
+
+template <typename T, std::size_t D, typename Compare>
+void pathfinders::IndexedOpenList<T, D, Compare>::clear() {
+    for (const auto& entry : mHeap) mPositions[entry.first] = kAbsent;
+    mHeap.clear();
+}
+
+/**
+ * @brief Prepare for indices in `[0, size)`.
+ * @note Reallocates only if `size` grows, otherwise only the remaining entries are cleared.
+*/
+template <typename T, std::size_t D, typename Compare>
+void pathfinders::IndexedOpenList<T, D, Compare>::reset(std::size_t size) {
+    clear();
+    if (mPositions.size() < size) mPositions.resize(size, kAbsent);
+}
+
+template <typename T, std::size_t D, typename Compare>
+void pathfinders::IndexedOpenList<T, D, Compare>::siftUp(std::size_t position) {
+    auto entry = std::move(mHeap[position]);
+
+    while (position) {
+        auto parent = (position - 1) / D;
+        if (!Compare{}(mHeap[parent].second, entry.second)) break;
+
+        mHeap[position] = std::move(mHeap[parent]);
+        mPositions[mHeap[position].first] = position;
+        position = parent;
+    }
+
+    mPositions[entry.first] = position;
+    mHeap[position] = std::move(entry);
+}
+
+template <typename T, std::size_t D, typename Compare>
+void pathfinders::IndexedOpenList<T, D, Compare>::siftDown(std::size_t position) {
+    auto entry = std::move(mHeap[position]);
+
+    while (true) {
+        auto first = position * D + 1;
+        if (first >= mHeap.size()) break;
+
+        // Select the child that takes precedence
+        auto child = first;
+        for (auto i = first + 1; i < std::min(first + D, mHeap.size()); ++i) if (Compare{}(mHeap[child].second, mHeap[i].second)) child = i;
+        if (!Compare{}(entry.second, mHeap[child].second)) break;
+
+        mHeap[position] = std::move(mHeap[child]);
+        mPositions[mHeap[position].first] = position;
+        position = child;
+    }
+
+    mPositions[entry.first] = position;
+    mHeap[position] = std::move(entry);
+}
+
+/**
+ * @brief Prepare for a new search over `size` cells.
+ * @note Reallocates only if `size` grows. Stamps are wiped only when the generation counter wraps around.
+*/
+void pathfinders::SearchContext::reset(std::size_t size) {
+    if (mData.size() < size) {
+        mData.resize(size);
+        mStamps.resize(size, 0);
+    }
+
+    if (!++mGeneration) {
+        std::fill(mStamps.begin(), mStamps.end(), 0);
+        mGeneration = 1;
+    }
+}
+
+pathfinders::Cell::Data& pathfinders::SearchContext::at(std::size_t index) {
+    if (mStamps[index] != mGeneration) {
+        mStamps[index] = mGeneration;
+        mData[index] = Cell::Data{};
+    }
+    return mData[index];
+}
+
+pathfinders::Components::Components(std::vector<std::vector<int>> const& grid) : mGrid(grid) {}
+
+bool pathfinders::Components::isValid(Cell const& cell) const {
+    return 0 <= cell.x && cell.x < mWidth && 0 <= cell.y && cell.y < mHeight;
+}
+
+/**
+ * @brief Label every component from scratch. Each cell then points directly to its root, so that lookups are `O(1)` until the next `update()`.
+*/
+void pathfinders::Components::build() {
+    clear();
+
+    mHeight = static_cast<int>(mGrid.size());
+    mWidth = mHeight ? static_cast<int>(mGrid.front().size()) : 0;
+    if (!mWidth) return;
+
+    auto size = static_cast<std::size_t>(mWidth) * mHeight;
+    mParents.assign(size, kNone);
+    mSizes.assign(size, 0);
+    mLevels.resize(size);
+    mStamps.assign(size, 0);
+    mGeneration = 1;
+    mQueue.reserve(size);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        auto cell = toCell(i);
+        mLevels[i] = mGrid[cell.y][cell.x];
+    }
+
+    for (std::size_t i = 0; i < size; ++i) if (mLevels[i] && mParents[i] == kNone) label(i);
+}
+
+/**
+ * @brief Notify that the collision level of `cell` has changed.
+ * @note Merging is near-constant. Splitting costs a breadth-first search over the former component of `cell`.
+*/
+void pathfinders::Components::update(Cell const& cell) {
+    if (!isBuilt() || !isValid(cell)) return;
+
+    auto index = toIndex(cell);
+    auto prevLevel = mLevels[index];
+    auto level = mGrid[cell.y][cell.x];
+    if (level == prevLevel) return;
+
+    mLevels[index] = level;
+    mParents[index] = kNone;
+
+    // Leaving a level might split its component, so every former neighbour is relabelled
+    if (prevLevel) {
+        if (!++mGeneration) {
+            std::fill(mStamps.begin(), mStamps.end(), 0);
+            mGeneration = 1;
+        }
+
+        for (const auto& direction : kDirections) {
+            auto neighbour = cell + direction;
+            if (isValid(neighbour) && mLevels[toIndex(neighbour)] == prevLevel && mStamps[toIndex(neighbour)] != mGeneration) label(toIndex(neighbour));
+        }
+    }
+
+    // Joining a level merges the components of every new neighbour
+    if (level) {
+        mParents[index] = index;
+        mSizes[index] = 1;
+
+        for (const auto& direction : kDirections) {
+            auto neighbour = cell + direction;
+            if (isValid(neighbour) && mLevels[toIndex(neighbour)] == level) unite(index, toIndex(neighbour));
+        }
+    }
+}
+
+void pathfinders::Components::clear() {
+    mWidth = mHeight = 0;
+    mParents.clear();
+    mSizes.clear();
+    mLevels.clear();
+    mStamps.clear();
+}
+
+/**
+ * @return whether `lhs` and `rhs` might be connected. Unbuilt or outdated labels, e.g. upon a grid resize, answer `true` so that searches are never wrongly rejected.
+*/
+bool pathfinders::Components::isConnected(Cell const& lhs, Cell const& rhs) const {
+    if (!isBuilt() || static_cast<int>(mGrid.size()) != mHeight || !isValid(lhs) || !isValid(rhs)) return true;
+
+    auto lhsIndex = toIndex(lhs), rhsIndex = toIndex(rhs);
+    if (mParents[lhsIndex] == kNone || mParents[rhsIndex] == kNone) return false;
+    return find(lhsIndex) == find(rhsIndex);
+}
+
+std::size_t pathfinders::Components::find(std::size_t index) const {
+    while (mParents[index] != index) {
+        mParents[index] = mParents[mParents[index]];   // Path halving
+        index = mParents[index];
+    }
+    return index;
+}
+
+void pathfinders::Components::unite(std::size_t lhs, std::size_t rhs) {
+    lhs = find(lhs);
+    rhs = find(rhs);
+    if (lhs == rhs) return;
+
+    // Union by size
+    if (mSizes[lhs] < mSizes[rhs]) std::swap(lhs, rhs);
+    mParents[rhs] = lhs;
+    mSizes[lhs] += mSizes[rhs];
+}
+
+/**
+ * @brief Breadth-first search from `root` over its collision level, making `root` the direct parent of every cell reached.
+*/
+void pathfinders::Components::label(std::size_t root) {
+    auto level = mLevels[root];
+
+    mQueue.clear();
+    mQueue.push_back(root);
+    mStamps[root] = mGeneration;
+
+    for (std::size_t head = 0; head < mQueue.size(); ++head) {
+        auto index = mQueue[head];
+        mParents[index] = root;
+
+        auto cell = toCell(index);
+        for (const auto& direction : kDirections) {
+            auto neighbour = cell + direction;
+            if (!isValid(neighbour)) continue;
+
+            auto neighbourIndex = toIndex(neighbour);
+            if (mLevels[neighbourIndex] != level || mStamps[neighbourIndex] == mGeneration) continue;
+
+            mStamps[neighbourIndex] = mGeneration;
+            mQueue.push_back(neighbourIndex);
+        }
+    }
+
+    mSizes[root] = mQueue.size();
+}
+
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+pathfinders::ASPF<H, M, P>::ASPF(std::vector<std::vector<int>> const& grid, Components const* components) : mGrid(grid), mComponents(components) {
     setBegin({ 0, 0 });
     setEnd({ static_cast<int>(mGrid.front().size()) - 1, static_cast<int>(mGrid.size()) - 1 });
 }
 
-template <pathfinders::Heuristic H, pathfinders::MovementType M>
-bool pathfinders::ASPF<H, M>::isValid(Cell const& cell) const {
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+bool pathfinders::ASPF<H, M, P>::isValid(Cell const& cell) const {
     return static_cast<int>(mBegin.x) <= cell.x && cell.x <= static_cast<int>(mEnd.x) && static_cast<int>(mBegin.y) <= cell.y && cell.y <= static_cast<int>(mEnd.y);
 }
 
-template <pathfinders::Heuristic H, pathfinders::MovementType M>
-bool pathfinders::ASPF<H, M>::isUnblocked(Cell const& cell) const {
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+bool pathfinders::ASPF<H, M, P>::isUnblocked(Cell const& cell) const {
     return mGrid[cell.y][cell.x] != 0;
 }
 
-template <pathfinders::Heuristic H, pathfinders::MovementType M>
-bool pathfinders::ASPF<H, M>::isUnblocked(Cell const& cell, Cell const& successor) const {
-    return mGrid[successor.y][successor.x] != 0;
+/**
+ * @note Mirrors `AbstractAnimatedDynamicEntity<T>::validateMove()` i.e. both cells must share the same non-zero collision level.
+*/
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+bool pathfinders::ASPF<H, M, P>::isUnblocked(Cell const& cell, Cell const& successor) const {
+    auto level = mGrid[cell.y][cell.x];
+    if (mGrid[successor.y][successor.x] == 0 || mGrid[successor.y][successor.x] != level) return false;
+
+    // Prevent diagonal moves from cutting corners
+    if constexpr(M == MovementType::k8Directional) if (successor.x != cell.x && successor.y != cell.y) return mGrid[cell.y][successor.x] == level && mGrid[successor.y][cell.x] == level;
+    return true;
 }
 
-template <pathfinders::Heuristic H, pathfinders::MovementType M>
-std::stack<pathfinders::Cell> pathfinders::ASPF<H, M>::getPath(std::vector<std::vector<Cell::Data>> const& cellData, Cell const& dest) const {
-    std::stack<Cell> path;
+/**
+ * @brief Write the path ending at `dest` into `path`, in reverse order i.e. `path.back()` is the source.
+*/
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+void pathfinders::ASPF<H, M, P>::getPath(Cell const& dest, std::vector<Cell>& path) const {
     auto curr = dest;
 
-    while (!(cellData[curr.y - mBegin.y][curr.x - mBegin.x].parent == curr)) {
-        path.push(curr);
-        curr = cellData[curr.y - mBegin.y][curr.x - mBegin.x].parent;
+    while (!(mContext.at(toIndex(curr)).parent == curr)) {
+        path.push_back(curr);
+        curr = mContext.at(toIndex(curr)).parent;
     }
 
-    path.push(curr);
-    return path;
+    path.push_back(curr);
 }
 
-template <pathfinders::Heuristic H, pathfinders::MovementType M>
-void pathfinders::ASPF<H, M>::setBegin(Cell const& begin) {
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+void pathfinders::ASPF<H, M, P>::setBegin(Cell const& begin) {
     mBegin = {
         std::max(0, begin.x),
         std::max(0, begin.y),
     };
 }
 
-template <pathfinders::Heuristic H, pathfinders::MovementType M>
-void pathfinders::ASPF<H, M>::setEnd(Cell const& end) {
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+void pathfinders::ASPF<H, M, P>::setEnd(Cell const& end) {
     mEnd = {
         std::min(static_cast<int>(mGrid.front().size()) - 1, end.x),
         std::min(static_cast<int>(mGrid.size()) - 1, end.y),
     };
 }
 
-template <pathfinders::Heuristic H, pathfinders::MovementType M>
-pathfinders::Result pathfinders::ASPF<H, M>::search(Cell const& src, Cell const& dest) const {
-    if (mGrid.empty()) return Result(Status::kFailure);
+/**
+ * @param path receives the resulting path in reverse order i.e. `path.back()` is `src` and `path.front()` is `dest`. Cleared regardless of the result, capacity is retained.
+*/
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+pathfinders::Status pathfinders::ASPF<H, M, P>::search(Cell const& src, Cell const& dest, std::vector<Cell>& path) const {
+    path.clear();
+    mExpandedCount = 0;
+    if (mGrid.empty()) return Status::kFailure;
     
-    if (!isValid(src)) return Result(Status::kInvalidSrc);
-    if (!isValid(dest)) return Result(Status::kInvalidDest);
-    if (!isUnblocked(src)) return Result(Status::kBlockedSrc);
-    if (!isUnblocked(dest)) return Result(Status::kBlockedDest);
-    if (src == dest) return Result(Status::kCoincidents);
-
-    // Note that index-based operations on two following lists require substracting `mBegin` to match `mGrid`
-    // Initialize closed list
-    std::vector<std::vector<bool>> closedList(mEnd.y - mBegin.y + 1, std::vector<bool>(mEnd.x - mBegin.x + 1, false));   // `false` means not visited (and vice versa)
-
-    // Initialize cell data list
-    std::vector<std::vector<Cell::Data>> cellDataList(mEnd.y - mBegin.y + 1, std::vector<Cell::Data>(mEnd.x - mBegin.x + 1, Cell::Data{}));
+    if (!isValid(src)) return Status::kInvalidSrc;
+    if (!isValid(dest)) return Status::kInvalidDest;
+    if (!isUnblocked(src)) return Status::kBlockedSrc;
+    if (!isUnblocked(dest)) return Status::kBlockedDest;
+    if (src == dest) return Status::kCoincidents;
+    if (mComponents != nullptr && !mComponents->isConnected(src, dest)) return Status::kFailure;   // Unreachable, rejected without exploring the whole region of `src`
+
+    // Reset in O(1), cells are indexed on the whole grid so that `mBegin` and `mEnd` may change freely between searches
+    mContext.reset(mGrid.size() * mGrid.front().size());
+    mOpenList.reset(mGrid.size() * mGrid.front().size());
     
     // Initialize starting node parameters
-    auto& srcData = cellDataList[src.y - mBegin.y][src.x - mBegin.x];
-    srcData.f = 0;
+    auto& srcData = mContext.at(toIndex(src));
+    srcData.g = 0;
+    srcData.h = Cell::getH<H>(src, dest);
+    srcData.f = srcData.h;
     srcData.parent = src;
 
-    // Initialize open list
-    OpenList<Cell::Pair> openList;
-    openList.push(Cell::Pair{ src });   // Place the starting cell on the open list
+    mOpenList.push(toIndex(src), Cell::Pair{ src, srcData.f });   // Place the starting cell on the open list
 
-    double g, h, f;
+    while (!mOpenList.empty()) {
+        auto parent = mOpenList.pop().cell;   // Remove cell with the least `f` from open list
+        auto& parentData = mContext.at(toIndex(parent));
 
-    while (!openList.empty()) {
-        g = h = f = 0;
+        if (parentData.isClosed) continue;   // Outdated duplicate
+        parentData.isClosed = true;   // Add cell to closed list
+        ++mExpandedCount;
 
-        auto parent = openList.pop().cell;   // Remove cell with the least `f` from open list
-        closedList[parent.y - mBegin.y][parent.x - mBegin.x] = true;   // Add cell to closed list
+        // Search is considered successful once destination is expanded
+        if (parent == dest) {
+            getPath(dest, path);
+            return Status::kSuccess;
+        }
 
         // Generate all successors
         for (const auto& direction : mDirections) {
             auto successor = parent + direction;
-            if (!isValid(successor)) continue;
+            if (!isValid(successor) || !isUnblocked(parent, successor)) continue;
+
+            auto& successorData = mContext.at(toIndex(successor));
+            if (successorData.isClosed) continue;
+
+            double g = parentData.g + Cell::getG(direction);
+            if (g >= successorData.g) continue;   // Successor is already on the open list with a better path
+
+            // Update successor data
+            successorData.g = g;
+            successorData.h = Cell::getH<H>(successor, dest);
+            successorData.f = g + successorData.h;
+            successorData.parent = parent;
+
+            mOpenList.push(toIndex(successor), Cell::Pair{ successor, successorData.f });
+        }
+    }
+
+    // Search is considered unsuccessful if the open list is emptied before destination cell is found
+    return Status::kFailure;
+}
+
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+pathfinders::JPSPF<H, M, P>::JPSPF(std::vector<std::vector<int>> const& grid, Components const* components) : mGrid(grid), mComponents(components) {
+    setBegin({ 0, 0 });
+    setEnd({ static_cast<int>(mGrid.front().size()) - 1, static_cast<int>(mGrid.size()) - 1 });
+}
+
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+void pathfinders::JPSPF<H, M, P>::setBegin(Cell const& begin) {
+    mBegin = {
+        std::max(0, begin.x),
+        std::max(0, begin.y),
+    };
+}
+
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+void pathfinders::JPSPF<H, M, P>::setEnd(Cell const& end) {
+    mEnd = {
+        std::min(static_cast<int>(mGrid.front().size()) - 1, end.x),
+        std::min(static_cast<int>(mGrid.size()) - 1, end.y),
+    };
+}
+
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+bool pathfinders::JPSPF<H, M, P>::isValid(Cell const& cell) const {
+    return mBegin.x <= cell.x && cell.x <= mEnd.x && mBegin.y <= cell.y && cell.y <= mEnd.y;
+}
+
+/**
+ * @note A search never leaves the collision level of its source, so "walkable" is relative to `mLevel`.
+*/
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+bool pathfinders::JPSPF<H, M, P>::isWalkable(Cell const& cell) const {
+    return isValid(cell) && mGrid[cell.y][cell.x] == mLevel;
+}
+
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+bool pathfinders::JPSPF<H, M, P>::isUnblocked(Cell const& parent, Cell const& successor) const {
+    if (!isWalkable(successor)) return false;
+    if (successor.x != parent.x && successor.y != parent.y) return isWalkable({ successor.x, parent.y }) && isWalkable({ parent.x, successor.y });
+    return true;
+}
+
+/**
+ * @brief Scan from `cell` along `direction` until a jump point, `mDest`, or an obstacle is met.
+ * @return the jump point or `mDest` if found, otherwise `std::nullopt`.
+*/
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+std::optional<pathfinders::Cell> pathfinders::JPSPF<H, M, P>::jump(Cell cell, Cell const& direction) const {
+    auto const& [dx, dy] = direction;
+
+    while (true) {
+        if (!isWalkable(cell)) return std::nullopt;
+        if (cell == mDest) return cell;
+
+        auto const& [x, y] = cell;
+
+        if (dx && dy) {
+            // When moving diagonally, check for horizontal and vertical jump points
+            if (jump({ x + dx, y }, { dx, 0 }).has_value() || jump({ x, y + dy }, { 0, dy }).has_value()) return cell;
+
+            // Diagonal moves may not cut corners
+            if (!isWalkable({ x + dx, y }) || !isWalkable({ x, y + dy })) return std::nullopt;
+        } else if (dx) {
+            if ((isWalkable({ x, y - 1 }) && !isWalkable({ x - dx, y - 1 })) || (isWalkable({ x, y + 1 }) && !isWalkable({ x - dx, y + 1 }))) return cell;
+        } else {
+            if ((isWalkable({ x - 1, y }) && !isWalkable({ x - 1, y - dy })) || (isWalkable({ x + 1, y }) && !isWalkable({ x + 1, y - dy }))) return cell;
+
+            // Without diagonal moves, horizontal jump points must be checked when moving vertically
+            if constexpr(M == MovementType::k4Directional) if (jump({ x + 1, y }, { 1, 0 }).has_value() || jump({ x - 1, y }, { -1, 0 }).has_value()) return cell;
+        }
 
-            // If successor is destination, search is considered successful
-            if (successor == dest) {
-                cellDataList[successor.y - mBegin.y][successor.x - mBegin.x].parent = parent;
-                return Result(Status::kSuccess, getPath(cellDataList, dest));
+        cell = cell + direction;
+    }
+}
+
+/**
+ * @brief Invoke `callable` on every direction worth jumping towards from `cell`, given it was reached from `parent`.
+*/
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+template <typename Callable>
+void pathfinders::JPSPF<H, M, P>::forEachNeighbour(Cell const& cell, Cell const& parent, Callable&& callable) const {
+    if (cell == parent) {
+        for (const auto& direction : mDirections) if (isUnblocked(cell, cell + direction)) callable(direction);
+        return;
+    }
+
+    int dx = (cell.x > parent.x) - (cell.x < parent.x);
+    int dy = (cell.y > parent.y) - (cell.y < parent.y);
+    auto const& [x, y] = cell;
+
+    if constexpr(M == MovementType::k8Directional) {
+        if (dx && dy) {
+            bool isHorizontalWalkable = isWalkable({ x + dx, y });
+            bool isVerticalWalkable = isWalkable({ x, y + dy });
+
+            if (isVerticalWalkable) callable(Cell{ 0, dy });
+            if (isHorizontalWalkable) callable(Cell{ dx, 0 });
+            if (isHorizontalWalkable && isVerticalWalkable) callable(Cell{ dx, dy });
+        } else if (dx) {
+            bool isNextWalkable = isWalkable({ x + dx, y });
+            bool isTopWalkable = isWalkable({ x, y - 1 });
+            bool isBottomWalkable = isWalkable({ x, y + 1 });
+
+            if (isNextWalkable) {
+                callable(Cell{ dx, 0 });
+                if (isTopWalkable) callable(Cell{ dx, -1 });
+                if (isBottomWalkable) callable(Cell{ dx, 1 });
             }
+            if (isTopWalkable) callable(Cell{ 0, -1 });
+            if (isBottomWalkable) callable(Cell{ 0, 1 });
+        } else {
+            bool isNextWalkable = isWalkable({ x, y + dy });
+            bool isLeftWalkable = isWalkable({ x - 1, y });
+            bool isRightWalkable = isWalkable({ x + 1, y });
+
+            if (isNextWalkable) {
+                callable(Cell{ 0, dy });
+                if (isLeftWalkable) callable(Cell{ -1, dy });
+                if (isRightWalkable) callable(Cell{ 1, dy });
+            }
+            if (isLeftWalkable) callable(Cell{ -1, 0 });
+            if (isRightWalkable) callable(Cell{ 1, 0 });
+        }
+    } else {
+        if (dx) {
+            callable(Cell{ 0, -1 });
+            callable(Cell{ 0, 1 });
+            callable(Cell{ dx, 0 });
+        } else {
+            callable(Cell{ -1, 0 });
+            callable(Cell{ 1, 0 });
+            callable(Cell{ 0, dy });
+        }
+    }
+}
+
+/**
+ * @brief Write the path ending at `dest` into `path`, in reverse order i.e. `path.back()` is the source. Cells between consecutive jump points are interpolated.
+*/
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+void pathfinders::JPSPF<H, M, P>::getPath(Cell const& dest, std::vector<Cell>& path) const {
+    auto curr = dest;
+
+    while (!(mContext.at(toIndex(curr)).parent == curr)) {
+        auto parent = mContext.at(toIndex(curr)).parent;
+        Cell step = { (parent.x > curr.x) - (parent.x < curr.x), (parent.y > curr.y) - (parent.y < curr.y) };
+        for (; !(curr == parent); curr = curr + step) path.push_back(curr);
+    }
+
+    path.push_back(curr);
+}
+
+/**
+ * @param path receives the resulting path in reverse order i.e. `path.back()` is `src` and `path.front()` is `dest`. Cleared regardless of the result, capacity is retained.
+*/
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+pathfinders::Status pathfinders::JPSPF<H, M, P>::search(Cell const& src, Cell const& dest, std::vector<Cell>& path) const {
+    path.clear();
+    mExpandedCount = 0;
+    if (mGrid.empty()) return Status::kFailure;
+
+    if (!isValid(src)) return Status::kInvalidSrc;
+    if (!isValid(dest)) return Status::kInvalidDest;
+    if (!mGrid[src.y][src.x]) return Status::kBlockedSrc;
+    if (!mGrid[dest.y][dest.x]) return Status::kBlockedDest;
+    if (src == dest) return Status::kCoincidents;
+    if (mComponents != nullptr && !mComponents->isConnected(src, dest)) return Status::kFailure;
+
+    mLevel = mGrid[src.y][src.x];
+    mDest = dest;
+
+    mContext.reset(mGrid.size() * mGrid.front().size());
+    mOpenList.reset(mGrid.size() * mGrid.front().size());
+
+    auto& srcData = mContext.at(toIndex(src));
+    srcData.g = 0;
+    srcData.h = Cell::getH<H>(src, dest);
+    srcData.f = srcData.h;
+    srcData.parent = src;
+
+    mOpenList.push(toIndex(src), Cell::Pair{ src, srcData.f });
+
+    while (!mOpenList.empty()) {
+        auto parent = mOpenList.pop().cell;
+        auto& parentData = mContext.at(toIndex(parent));
+
+        if (parentData.isClosed) continue;   // Outdated duplicate
+        parentData.isClosed = true;
+        ++mExpandedCount;
+
+        if (parent == dest) {
+            getPath(dest, path);
+            return Status::kSuccess;
+        }
+
+        forEachNeighbour(parent, parentData.parent, [&](Cell const& direction) {
+            auto successor = jump(parent + direction, direction);
+            if (!successor.has_value()) return;
+
+            auto& successorData = mContext.at(toIndex(successor.value()));
+            if (successorData.isClosed) return;
+
+            double g = parentData.g + Cell::getG({ successor->x - parent.x, successor->y - parent.y });
+            if (g >= successorData.g) return;
+
+            successorData.g = g;
+            successorData.h = Cell::getH<H>(successor.value(), dest);
+            successorData.f = g + successorData.h;
+            successorData.parent = parent;
+
+            mOpenList.push(toIndex(successor.value()), Cell::Pair{ successor.value(), successorData.f });
+        });
+    }
+
+    return Status::kFailure;
+}
+
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+pathfinders::JPSPlusPF<H, M, P>::JPSPlusPF(std::vector<std::vector<int>> const& grid, Components const* components) : mGrid(grid), mComponents(components) {
+    precompute();
+}
+
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+bool pathfinders::JPSPlusPF<H, M, P>::isValid(Cell const& cell) const {
+    return 0 <= cell.x && cell.x < mWidth && 0 <= cell.y && cell.y < mHeight;
+}
+
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+bool pathfinders::JPSPlusPF<H, M, P>::isWalkable(Cell const& cell, int level) const {
+    return isValid(cell) && mGrid[cell.y][cell.x] == level;
+}
+
+/**
+ * @brief Check whether `cell` has a forced neighbour when entered along orthogonal `direction` i.e. whether it is a primary jump point.
+*/
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+bool pathfinders::JPSPlusPF<H, M, P>::isJumpPoint(Cell const& cell, Cell const& direction) const {
+    auto const& [x, y] = cell;
+    auto const& [dx, dy] = direction;
+    auto level = mGrid[y][x];
+
+    if (dx) return (isWalkable({ x, y - 1 }, level) && !isWalkable({ x - dx, y - 1 }, level)) || (isWalkable({ x, y + 1 }, level) && !isWalkable({ x - dx, y + 1 }, level));
+    return (isWalkable({ x - 1, y }, level) && !isWalkable({ x - 1, y - dy }, level)) || (isWalkable({ x + 1, y }, level) && !isWalkable({ x + 1, y - dy }, level));
+}
+
+/**
+ * @brief Build the distance table. Each direction is a single sweep against that direction, so the whole table costs `O(8n)`.
+ * @note Positive values are the distance to the next jump point, non-positive values the (negated) distance to the next wall. Walls are relative to the collision level of each cell.
+*/
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+void pathfinders::JPSPlusPF<H, M, P>::precompute() {
+    mHeight = static_cast<int>(mGrid.size());
+    mWidth = mHeight ? static_cast<int>(mGrid.front().size()) : 0;
+    mDistances.assign(static_cast<std::size_t>(mWidth) * mHeight, {});
+
+    auto getDirectionIndex = [](Cell const& direction) {
+        return static_cast<std::size_t>(std::find(mDirections.begin(), mDirections.end(), direction) - mDirections.begin());
+    };
+
+    auto sweep = [&](Cell const& direction, auto&& calculate) {
+        // Visit `cell + direction` before `cell`
+        for (int j = 0; j < mHeight; ++j) for (int i = 0; i < mWidth; ++i) {
+            Cell cell = { direction.x > 0 ? mWidth - 1 - i : i, direction.y > 0 ? mHeight - 1 - j : j };
+            if (mGrid[cell.y][cell.x]) calculate(cell);
+        }
+    };
+
+    auto accumulate = [](int distance) { return distance > 0 ? distance + 1 : distance - 1; };
+
+    // Orthogonal directions first, since diagonal ones depend on them
+    for (std::size_t k = 0; k < 4; ++k) {
+        auto direction = mDirections[k];
+        sweep(direction, [&](Cell const& cell) {
+            auto successor = cell + direction;
+            int& distance = mDistances[toIndex(cell)][k];
+
+            if (!isWalkable(successor, mGrid[cell.y][cell.x])) distance = 0;
+            else if (isJumpPoint(successor, direction)) distance = 1;
+            else distance = accumulate(mDistances[toIndex(successor)][k]);
+        });
+    }
+
+    for (std::size_t k = 4; k < 8; ++k) {
+        auto direction = mDirections[k];
+        auto horizontal = getDirectionIndex({ direction.x, 0 });
+        auto vertical = getDirectionIndex({ 0, direction.y });
 
-            // Ignore if successor is already on the closed list or is blocked
-            if (!closedList[successor.y - mBegin.y][successor.x - mBegin.x] && isUnblocked(successor)) {
-                g = cellDataList[parent.y - mBegin.y][parent.x - mBegin.x].g + Cell::getG(direction);
-                h = Cell::getH<H>(successor, dest);
-                f = g + h;
+        sweep(direction, [&](Cell const& cell) {
+            auto successor = cell + direction;
+            auto level = mGrid[cell.y][cell.x];
+            int& distance = mDistances[toIndex(cell)][k];
 
-                auto& successorData = cellDataList[successor.y - mBegin.y][successor.x - mBegin.x];
+            if (!isWalkable(successor, level) || !isWalkable({ successor.x, cell.y }, level) || !isWalkable({ cell.x, successor.y }, level)) distance = 0;
+            else if (mDistances[toIndex(successor)][horizontal] > 0 || mDistances[toIndex(successor)][vertical] > 0) distance = 1;
+            else distance = accumulate(mDistances[toIndex(successor)][k]);
+        });
+    }
+}
+
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+void pathfinders::JPSPlusPF<H, M, P>::getPath(Cell const& dest, std::vector<Cell>& path) const {
+    auto curr = dest;
+
+    while (!(mContext.at(toIndex(curr)).parent == curr)) {
+        auto parent = mContext.at(toIndex(curr)).parent;
+        Cell step = { (parent.x > curr.x) - (parent.x < curr.x), (parent.y > curr.y) - (parent.y < curr.y) };
+        for (; !(curr == parent); curr = curr + step) path.push_back(curr);
+    }
+
+    path.push_back(curr);
+}
+
+/**
+ * @param path receives the resulting path in reverse order i.e. `path.back()` is `src` and `path.front()` is `dest`. Cleared regardless of the result, capacity is retained.
+*/
+template <pathfinders::Heuristic H, pathfinders::MovementType M, pathfinders::OpenListPolicy P>
+pathfinders::Status pathfinders::JPSPlusPF<H, M, P>::search(Cell const& src, Cell const& dest, std::vector<Cell>& path) const {
+    path.clear();
+    mExpandedCount = 0;
+    if (mDistances.empty()) return Status::kFailure;
+
+    if (!isValid(src)) return Status::kInvalidSrc;
+    if (!isValid(dest)) return Status::kInvalidDest;
+    if (!mGrid[src.y][src.x]) return Status::kBlockedSrc;
+    if (!mGrid[dest.y][dest.x]) return Status::kBlockedDest;
+    if (src == dest) return Status::kCoincidents;
+    if (mComponents != nullptr && !mComponents->isConnected(src, dest)) return Status::kFailure;
+
+    mContext.reset(mDistances.size());
+    mOpenList.reset(mDistances.size());
+
+    auto& srcData = mContext.at(toIndex(src));
+    srcData.g = 0;
+    srcData.h = Cell::getH<H>(src, dest);
+    srcData.f = srcData.h;
+    srcData.parent = src;
+
+    mOpenList.push(toIndex(src), Cell::Pair{ src, srcData.f });
+
+    while (!mOpenList.empty()) {
+        auto parent = mOpenList.pop().cell;
+        auto& parentData = mContext.at(toIndex(parent));
 
-                // Add successor to the open list if successor is not on the open list or provides a better path
-                if (successorData.f == std::numeric_limits<double>::max() || successorData.f > f) {
-                    openList.push(Cell::Pair({ successor, f }));
+        if (parentData.isClosed) continue;   // Outdated duplicate
+        parentData.isClosed = true;
+        ++mExpandedCount;
 
-                    // Update successor data
-                    successorData.f = f;
-                    successorData.g = g;
-                    successorData.h = h;
-                    successorData.parent = parent;
+        if (parent == dest) {
+            getPath(dest, path);
+            return Status::kSuccess;
+        }
+
+        // Directions worth considering, given the direction of travel
+        int px = (parent.x > parentData.parent.x) - (parent.x < parentData.parent.x);
+        int py = (parent.y > parentData.parent.y) - (parent.y < parentData.parent.y);
+        int dx = dest.x - parent.x, dy = dest.y - parent.y;
+
+        for (std::size_t k = 0; k < mDirections.size(); ++k) {
+            auto const& direction = mDirections[k];
+
+            if (px || py) {
+                if (px && py && !((direction.x == px && direction.y == 0) || (direction.x == 0 && direction.y == py) || (direction.x == px && direction.y == py))) continue;   // Diagonal travel: both components and the diagonal itself
+                if (!(px && py) && ((px && direction.x == -px) || (py && direction.y == -py))) continue;   // Orthogonal travel: everything but backwards
+            }
+
+            int distance = mDistances[toIndex(parent)][k];
+            std::optional<Cell> successor;
+
+            if (!direction.x || !direction.y) {
+                // `dest` lies exactly ahead, before any wall or jump point
+                bool isAhead = direction.x ? (dy == 0 && dx * direction.x > 0 && std::abs(dx) <= std::abs(distance)) : (dx == 0 && dy * direction.y > 0 && std::abs(dy) <= std::abs(distance));
+                if (isAhead) successor = dest;
+                else if (distance > 0) successor = Cell{ parent.x + direction.x * distance, parent.y + direction.y * distance };
+            } else {
+                // `dest` lies in this quadrant and its row or column is reachable diagonally
+                bool isWithinQuadrant = dx * direction.x > 0 && dy * direction.y > 0 && (std::abs(dx) <= std::abs(distance) || std::abs(dy) <= std::abs(distance));
+                if (isWithinQuadrant) {
+                    int steps = std::min(std::abs(dx), std::abs(dy));
+                    successor = Cell{ parent.x + direction.x * steps, parent.y + direction.y * steps };
                 }
+                else if (distance > 0) successor = Cell{ parent.x + direction.x * distance, parent.y + direction.y * distance };
             }
+
+            if (!successor.has_value()) continue;
+
+            auto& successorData = mContext.at(toIndex(successor.value()));
+            if (successorData.isClosed) continue;
+
+            double g = parentData.g + Cell::getG({ successor->x - parent.x, successor->y - parent.y });
+            if (g >= successorData.g) continue;
+
+            successorData.g = g;
+            successorData.h = Cell::getH<H>(successor.value(), dest);
+            successorData.f = g + successorData.h;
+            successorData.parent = parent;
+
+            mOpenList.push(toIndex(successor.value()), Cell::Pair{ successor.value(), successorData.f });
         }
     }
 
-    // Search is considered unsuccessful if the open list is emptied before destination cell is found
-    return Result(Status::kFailure);
+    return Status::kFailure;
+}
+
+pathfinders::FlowField::FlowField(std::vector<std::vector<int>> const& grid) : mGrid(grid) {}
+
+bool pathfinders::FlowField::isValid(Cell const& cell) const {
+    return 0 <= cell.x && cell.x < mWidth && 0 <= cell.y && cell.y < mHeight;
+}
+
+bool pathfinders::FlowField::isUnblocked(Cell const& parent, Cell const& successor) const {
+    return mGrid[successor.y][successor.x] != 0 && mGrid[successor.y][successor.x] == mGrid[parent.y][parent.x];
+}
+
+/**
+ * @brief Rebuild the field from scratch via breadth-first search from `goal`.
+ * @note Storage is only reallocated if the grid dimensions change.
+*/
+void pathfinders::FlowField::build(Cell const& goal) {
+    mHeight = static_cast<int>(mGrid.size());
+    mWidth = mHeight ? static_cast<int>(mGrid.front().size()) : 0;
+
+    mValues.assign(static_cast<std::size_t>(mWidth) * mHeight, kUnreachableValue);
+    mQueue.resize(mValues.size());
+    mOffset = 0;
+    mGoal = goal;
+    mIsBuilt = true;
+
+    if (!isValid(goal) || !mGrid[goal.y][goal.x]) return;
+
+    // `mQueue` never holds more than one entry per cell, so plain indices suffice
+    std::size_t head = 0, tail = 0;
+    mValues[toIndex(goal)] = 0;
+    mQueue[tail++] = toIndex(goal);
+
+    while (head != tail) {
+        auto index = mQueue[head++];
+        Cell parent = { static_cast<int>(index % mWidth), static_cast<int>(index / mWidth) };
+
+        for (const auto& direction : kDirections) {
+            auto successor = parent + direction;
+            if (!isValid(successor) || !isUnblocked(parent, successor) || mValues[toIndex(successor)] != kUnreachableValue) continue;
+
+            mValues[toIndex(successor)] = mValues[index] + 1;
+            mQueue[tail++] = toIndex(successor);
+        }
+    }
+}
+
+/**
+ * @brief Move the field to `goal`, repairing it in place if `goal` is connected and adjacent to the current goal.
+ * @note A 4-directional grid is bipartite, so moving the goal by one step changes every reachable distance by exactly `1`. Distances decrease for cells whose shortest path may pass through the new goal i.e. the cells reachable from it via strictly increasing distances, and increase for everything else. The latter is applied lazily via `mOffset`, so the repair only visits the former.
+*/
+void pathfinders::FlowField::update(Cell const& goal) {
+    if (mIsBuilt && goal == mGoal) return;
+
+    bool isAdjacent = mIsBuilt && std::abs(goal.x - mGoal.x) + std::abs(goal.y - mGoal.y) == 1;
+    if (!isAdjacent || !isValid(goal) || !isValid(mGoal) || !isUnblocked(mGoal, goal) || mValues[toIndex(mGoal)] == kUnreachableValue) {
+        build(goal);
+        return;
+    }
+
+    ++mOffset;
+
+    // Visited cells are decremented on enqueue, so a neighbour that satisfies `old(successor) == old(parent) + 1` is necessarily unvisited
+    std::size_t head = 0, tail = 0;
+    mValues[toIndex(goal)] -= 2;
+    mQueue[tail++] = toIndex(goal);
+
+    while (head != tail) {
+        auto index = mQueue[head++];
+        Cell parent = { static_cast<int>(index % mWidth), static_cast<int>(index / mWidth) };
+
+        for (const auto& direction : kDirections) {
+            auto successor = parent + direction;
+            if (!isValid(successor) || !isUnblocked(parent, successor) || mValues[toIndex(successor)] != mValues[index] + 3) continue;
+
+            mValues[toIndex(successor)] -= 2;
+            mQueue[tail++] = toIndex(successor);
+        }
+    }
+
+    mGoal = goal;
+}
+
+void pathfinders::FlowField::clear() {
+    mIsBuilt = false;
+    mValues.clear();
+    mOffset = 0;
 }
 
+unsigned int pathfinders::FlowField::getDistance(Cell const& cell) const {
+    if (!mIsBuilt || !isValid(cell) || mValues[toIndex(cell)] == kUnreachableValue) return kUnreachable;
+    return static_cast<unsigned int>(mValues[toIndex(cell)] + mOffset);
+}
+
+/**
+ * @return the neighbour of `cell` that is one step closer to the goal, or `std::nullopt` if `cell` is the goal or cannot reach it.
+*/
+std::optional<pathfinders::Cell> pathfinders::FlowField::getNextCell(Cell const& cell) const {
+    auto distance = getDistance(cell);
+    if (distance == kUnreachable || !distance) return std::nullopt;
+
+    for (const auto& direction : kDirections) {
+        auto successor = cell + direction;
+        if (isValid(successor) && isUnblocked(cell, successor) && getDistance(successor) == distance - 1) return successor;
+    }
+
+    return std::nullopt;
+}
+
+pathfinders::FlowFieldCache::FlowFieldCache(std::vector<std::vector<int>> const& grid, std::size_t size) : mFields(size, FlowField(grid)), mLastUsed(size, 0) {}
+
+/**
+ * @brief Retrieve the field rooted at `goal`. In order of preference: an exact match, a field whose goal is adjacent to `goal` (repaired in place), or the least recently used field (rebuilt).
+*/
+pathfinders::FlowField const& pathfinders::FlowFieldCache::get(Cell const& goal) {
+    std::size_t adjacent = mFields.size();
+    std::size_t lru = 0;
+
+    for (std::size_t i = 0; i < mFields.size(); ++i) {
+        auto const& field = mFields[i];
+
+        if (field.isBuilt() && field.getGoal() == goal) {
+            mLastUsed[i] = ++mClock;
+            return field;
+        }
+
+        if (field.isBuilt() && std::abs(field.getGoal().x - goal.x) + std::abs(field.getGoal().y - goal.y) == 1 && (adjacent == mFields.size() || mLastUsed[i] < mLastUsed[adjacent])) adjacent = i;
+        if (mLastUsed[i] < mLastUsed[lru]) lru = i;
+    }
+
+    auto i = adjacent != mFields.size() ? adjacent : lru;
+    mFields[i].update(goal);
+    mLastUsed[i] = ++mClock;
+    return mFields[i];
+}
+
+void pathfinders::FlowFieldCache::clear() {
+    for (auto& field : mFields) field.clear();
+    std::fill(mLastUsed.begin(), mLastUsed.end(), 0);
+    mClock = 0;
+}
+
+
+pathfinders::HPAPF::HPAPF(std::vector<std::vector<int>> const& grid, int clusterSize, Components const* components) : mGrid(grid), mComponents(components), mClusterSize(clusterSize) {}
+
+bool pathfinders::HPAPF::isValid(Cell const& cell) const {
+    return 0 <= cell.x && cell.x < mWidth && 0 <= cell.y && cell.y < mHeight;
+}
+
+bool pathfinders::HPAPF::isUnblocked(Cell const& parent, Cell const& successor) const {
+    return mGrid[successor.y][successor.x] != 0 && mGrid[successor.y][successor.x] == mGrid[parent.y][parent.x];
+}
+
+bool pathfinders::HPAPF::isWithinCluster(Cell const& cell, std::size_t index) const {
+    return isValid(cell) && toClusterIndex(cell) == index;
+}
+
+/**
+ * @brief Partition the grid into clusters, then place entrances and precompute intra-cluster costs.
+ * @note Should be called whenever the grid is replaced. For local changes, see `update()`.
+*/
+void pathfinders::HPAPF::build() {
+    clear();
+
+    mHeight = static_cast<int>(mGrid.size());
+    mWidth = mHeight ? static_cast<int>(mGrid.front().size()) : 0;
+    if (!mWidth) return;
+
+    mClusterCount = { (mWidth + mClusterSize - 1) / mClusterSize, (mHeight + mClusterSize - 1) / mClusterSize };
+    mClusters.resize(static_cast<std::size_t>(mClusterCount.x) * mClusterCount.y);
+    mNodeIndices.assign(static_cast<std::size_t>(mWidth) * mHeight, -1);
+
+    mFloodDistances.resize(static_cast<std::size_t>(mClusterSize) * mClusterSize);
+    mFloodParents.resize(mFloodDistances.size());
+    mFloodQueue.reserve(mFloodDistances.size());
+
+    for (std::size_t i = 0; i < mClusters.size(); ++i) addBorders(i);
+    for (std::size_t i = 0; i < mClusters.size(); ++i) connect(i);
+}
+
+/**
+ * @brief Repair the abstract graph after the collision level of `cell` has changed.
+ * @note Only the cluster containing `cell` and its 4 neighbours, whose shared borders might have changed, are recomputed.
+*/
+void pathfinders::HPAPF::update(Cell const& cell) {
+    if (!isBuilt() || !isValid(cell)) return;
+
+    Cell origin = { cell.x / mClusterSize, cell.y / mClusterSize };
+    auto getIndex = [&](Cell const& cluster) { return static_cast<std::size_t>(cluster.y) * mClusterCount.x + cluster.x; };
+    auto isValidCluster = [&](Cell const& cluster) { return 0 <= cluster.x && cluster.x < mClusterCount.x && 0 <= cluster.y && cluster.y < mClusterCount.y; };
+
+    std::vector<Cell> affected = { origin };
+    for (const auto& direction : kDirections) if (isValidCluster(origin + direction)) affected.push_back(origin + direction);
+
+    for (const auto& cluster : affected) {
+        auto& nodes = mClusters[getIndex(cluster)].nodes;
+        for (const auto& node : nodes) mNodeIndices[toIndex(node)] = -1;
+        nodes.clear();
+    }
+
+    // Each cluster owns its right and bottom borders, so the left and top borders of an affected cluster are re-added through its neighbours
+    for (const auto& cluster : affected) {
+        addBorders(getIndex(cluster));
+        if (isValidCluster(cluster + Cell{ -1, 0 })) addBorders(getIndex(cluster + Cell{ -1, 0 }));
+        if (isValidCluster(cluster + Cell{ 0, -1 })) addBorders(getIndex(cluster + Cell{ 0, -1 }));
+    }
+
+    for (const auto& cluster : affected) connect(getIndex(cluster));
+}
+
+void pathfinders::HPAPF::clear() {
+    mClusters.clear();
+    mNodeIndices.clear();
+    mWidth = mHeight = 0;
+    mClusterCount = { 0, 0 };
+}
+
+/**
+ * @brief Add the entrances along the right and bottom borders of cluster `index`.
+*/
+void pathfinders::HPAPF::addBorders(std::size_t index) {
+    auto origin = getClusterOrigin(index);
+    Cell end = { std::min(origin.x + mClusterSize, mWidth) - 1, std::min(origin.y + mClusterSize, mHeight) - 1 };
+
+    if (origin.x + mClusterSize < mWidth) addEntrances({ end.x, origin.y }, end, { 1, 0 });
+    if (origin.y + mClusterSize < mHeight) addEntrances({ origin.x, end.y }, end, { 0, 1 });
+}
+
+/**
+ * @brief Scan the border from `begin` to `end` for maximal runs of cells connected to their neighbour `across` the border, and add a transition for each run.
+ * @note A run is broken by a blocked cell or by a change of collision level.
+*/
+void pathfinders::HPAPF::addEntrances(Cell const& begin, Cell const& end, Cell const& across) {
+    Cell step = { across.y, across.x };
+    int count = (end.x - begin.x) + (end.y - begin.y) + 1;
+
+    auto at = [&](int k) { return Cell{ begin.x + step.x * k, begin.y + step.y * k }; };
+    auto addTransition = [&](Cell const& cell) {
+        addNode(cell);
+        addNode(cell + across);
+    };
+    auto addRun = [&](int first, int last) {
+        if (last - first + 1 < kMaxEntranceWidth) addTransition(at((first + last) / 2));
+        else {
+            addTransition(at(first));
+            addTransition(at(last));
+        }
+    };
+
+    int first = -1;
+    for (int k = 0; k < count; ++k) {
+        auto cell = at(k);
+        bool isOpen = isUnblocked(cell, cell + across);
+
+        if (first != -1 && (!isOpen || mGrid[cell.y][cell.x] != mGrid[at(first).y][at(first).x])) {
+            addRun(first, k - 1);
+            first = -1;
+        }
+        if (isOpen && first == -1) first = k;
+    }
+    if (first != -1) addRun(first, count - 1);
+}
+
+void pathfinders::HPAPF::addNode(Cell const& cell) {
+    auto& index = mNodeIndices[toIndex(cell)];
+    if (index != -1) return;
+
+    auto& nodes = mClusters[toClusterIndex(cell)].nodes;
+    index = static_cast<int>(nodes.size());
+    nodes.push_back(cell);
+}
+
+/**
+ * @brief Precompute the pairwise distances between the entrances of cluster `index`, without leaving the cluster.
+*/
+void pathfinders::HPAPF::connect(std::size_t index) {
+    auto& cluster = mClusters[index];
+    auto count = cluster.nodes.size();
+    cluster.costs.assign(count * count, kUnreachable);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        flood(cluster.nodes[i]);
+        for (std::size_t j = 0; j < count; ++j) cluster.costs[i * count + j] = getFloodDistance(cluster.nodes[j]);
+    }
+}
+
+/**
+ * @brief Breadth-first search from `src`, confined to its cluster. Results are read through `getFloodDistance()` and `mFloodParents`.
+*/
+void pathfinders::HPAPF::flood(Cell const& src) const {
+    mFloodCluster = toClusterIndex(src);
+    std::fill(mFloodDistances.begin(), mFloodDistances.end(), kUnreachable);
+    std::fill(mFloodParents.begin(), mFloodParents.end(), -1);
+
+    mFloodQueue.clear();
+    mFloodQueue.push_back(src);
+    mFloodDistances[toLocalIndex(src)] = 0;
+
+    for (std::size_t head = 0; head < mFloodQueue.size(); ++head) {
+        auto cell = mFloodQueue[head];
+
+        for (const auto& direction : kDirections) {
+            auto successor = cell + direction;
+            if (!isWithinCluster(successor, mFloodCluster) || !isUnblocked(cell, successor)) continue;
+
+            auto& distance = mFloodDistances[toLocalIndex(successor)];
+            if (distance != kUnreachable) continue;
+
+            distance = mFloodDistances[toLocalIndex(cell)] + 1;
+            mFloodParents[toLocalIndex(successor)] = static_cast<int>(toLocalIndex(cell));
+            mFloodQueue.push_back(successor);
+        }
+    }
+}
+
+/**
+ * @brief Search the abstract graph, with `src` and `dest` temporarily connected to the entrances of their clusters.
+ * @param waypoints receives the abstract path in reverse order i.e. `waypoints.back()` is `src` and `waypoints.front()` is `dest`. Consecutive waypoints either share a cluster or are adjacent.
+*/
+pathfinders::Status pathfinders::HPAPF::search(Cell const& src, Cell const& dest, std::vector<Cell>& waypoints) const {
+    waypoints.clear();
+    mExpandedCount = 0;
+    if (!isBuilt()) return Status::kFailure;
+
+    if (!isValid(src)) return Status::kInvalidSrc;
+    if (!isValid(dest)) return Status::kInvalidDest;
+    if (!mGrid[src.y][src.x]) return Status::kBlockedSrc;
+    if (!mGrid[dest.y][dest.x]) return Status::kBlockedDest;
+    if (src == dest) return Status::kCoincidents;
+    if (mGrid[src.y][src.x] != mGrid[dest.y][dest.x]) return Status::kFailure;   // Different collision levels are never connected
+    if (mComponents != nullptr && !mComponents->isConnected(src, dest)) return Status::kFailure;
+
+    auto srcCluster = toClusterIndex(src);
+    auto destCluster = toClusterIndex(dest);
+    auto const& srcNodes = mClusters[srcCluster].nodes;
+    auto const& destNodes = mClusters[destCluster].nodes;
+
+    // Temporarily connect `src` and `dest` to the entrances of their clusters
+    flood(dest);
+    mDestCosts.resize(destNodes.size());
+    for (std::size_t i = 0; i < destNodes.size(); ++i) mDestCosts[i] = getFloodDistance(destNodes[i]);
+
+    flood(src);
+    mSrcCosts.resize(srcNodes.size());
+    for (std::size_t i = 0; i < srcNodes.size(); ++i) mSrcCosts[i] = getFloodDistance(srcNodes[i]);
+    auto directCost = srcCluster == destCluster ? getFloodDistance(dest) : kUnreachable;
+
+    mContext.reset(static_cast<std::size_t>(mWidth) * mHeight);
+    mOpenList.clear();
+
+    auto& srcData = mContext.at(toIndex(src));
+    srcData.g = 0;
+    srcData.h = Cell::getH<Heuristic::kManhattan>(src, dest);
+    srcData.f = srcData.h;
+    srcData.parent = src;
+
+    mOpenList.push(Cell::Pair{ src, srcData.f });
+
+    auto relax = [&](Cell const& parent, double g, Cell const& successor, unsigned int cost) {
+        if (cost == kUnreachable) return;
+
+        auto& successorData = mContext.at(toIndex(successor));
+        if (successorData.isClosed || g + cost >= successorData.g) return;
+
+        successorData.g = g + cost;
+        successorData.h = Cell::getH<Heuristic::kManhattan>(successor, dest);
+        successorData.f = successorData.g + successorData.h;
+        successorData.parent = parent;
+
+        mOpenList.push(Cell::Pair{ successor, successorData.f });
+    };
+
+    while (!mOpenList.empty()) {
+        auto parent = mOpenList.pop().cell;
+        auto& parentData = mContext.at(toIndex(parent));
+
+        if (parentData.isClosed) continue;   // Outdated duplicate
+        parentData.isClosed = true;
+        ++mExpandedCount;
+
+        if (parent == dest) {
+            for (auto curr = dest; !(curr == src); curr = mContext.at(toIndex(curr)).parent) waypoints.push_back(curr);
+            waypoints.push_back(src);
+            return Status::kSuccess;
+        }
+
+        auto cluster = toClusterIndex(parent);
+        auto index = mNodeIndices[toIndex(parent)];
+
+        // Intra-cluster edges
+        if (parent == src) {
+            for (std::size_t i = 0; i < srcNodes.size(); ++i) relax(parent, parentData.g, srcNodes[i], mSrcCosts[i]);
+            relax(parent, parentData.g, dest, directCost);
+        } else {
+            auto const& nodes = mClusters[cluster].nodes;
+            auto const& costs = mClusters[cluster].costs;
+            for (std::size_t i = 0; i < nodes.size(); ++i) if (static_cast<int>(i) != index) relax(parent, parentData.g, nodes[i], costs[index * nodes.size() + i]);
+            if (cluster == destCluster) relax(parent, parentData.g, dest, mDestCosts[index]);
+        }
+
+        // Inter-cluster edges
+        if (index == -1) continue;
+        for (const auto& direction : kDirections) {
+            auto successor = parent + direction;
+            if (isValid(successor) && toClusterIndex(successor) != cluster && mNodeIndices[toIndex(successor)] != -1 && isUnblocked(parent, successor)) relax(parent, parentData.g, successor, 1);
+        }
+    }
+
+    return Status::kFailure;
+}
+
+/**
+ * @brief Expand a pair of consecutive waypoints into the concrete path between them.
+ * @param path receives the path in reverse order i.e. `path.back()` is `src` and `path.front()` is `dest`.
+ * @note Costs at most one in-cluster breadth-first search.
+*/
+pathfinders::Status pathfinders::HPAPF::refine(Cell const& src, Cell const& dest, std::vector<Cell>& path) const {
+    path.clear();
+    if (!isBuilt()) return Status::kFailure;
+
+    if (!isValid(src)) return Status::kInvalidSrc;
+    if (!isValid(dest)) return Status::kInvalidDest;
+    if (src == dest) return Status::kCoincidents;
+
+    auto cluster = toClusterIndex(src);
+
+    // Waypoints in different clusters are connected by a single step
+    if (toClusterIndex(dest) != cluster) {
+        if (std::abs(dest.x - src.x) + std::abs(dest.y - src.y) != 1 || !isUnblocked(src, dest)) return Status::kFailure;
+        path.push_back(dest);
+        path.push_back(src);
+        return Status::kSuccess;
+    }
+
+    flood(src);
+    if (getFloodDistance(dest) == kUnreachable) return Status::kFailure;
+
+    auto origin = getClusterOrigin(cluster);
+    for (auto curr = dest; !(curr == src); ) {
+        path.push_back(curr);
+        auto parent = mFloodParents[toLocalIndex(curr)];
+        curr = { origin.x + parent % mClusterSize, origin.y + parent / mClusterSize };
+    }
+    path.push_back(src);
+
+    return Status::kSuccess;
+}
+
+
+pathfinders::DSLPF::DSLPF(std::vector<std::vector<int>> const& grid, Components const* components) : mGrid(grid), mComponents(components) {}
+
+/**
+ * @brief Restrict searches to cells at or after `begin`, e.g. around the searching entity, so that their cost does not scale with the level.
+ * @note Discards the search state if the window changes.
+*/
+void pathfinders::DSLPF::setBegin(Cell const& begin) {
+    if (begin == mBegin) return;
+    mBegin = begin;
+    mIsInitialized = false;
+}
+
+/**
+ * @see `setBegin()`.
+*/
+void pathfinders::DSLPF::setEnd(Cell const& end) {
+    if (end == mEnd) return;
+    mEnd = end;
+    mIsInitialized = false;
+}
+
+bool pathfinders::DSLPF::isValid(Cell const& cell) const {
+    return std::max(0, mBegin.x) <= cell.x && cell.x < std::min(mWidth, mEnd.x + 1) && std::max(0, mBegin.y) <= cell.y && cell.y < std::min(mHeight, mEnd.y + 1);
+}
+
+bool pathfinders::DSLPF::isUnblocked(Cell const& parent, Cell const& successor) const {
+    return isValid(successor) && !mBlocked[toIndex(parent)] && !mBlocked[toIndex(successor)] && mGrid[successor.y][successor.x] != 0 && mGrid[successor.y][successor.x] == mGrid[parent.y][parent.x];
+}
+
+/**
+ * @brief Discard all state if the grid has been resized since, e.g. upon level change.
+*/
+void pathfinders::DSLPF::fit() {
+    int height = static_cast<int>(mGrid.size());
+    int width = height ? static_cast<int>(mGrid.front().size()) : 0;
+    if (width == mWidth && height == mHeight) return;
+
+    clear();
+    mWidth = width;
+    mHeight = height;
+    mBlocked.assign(static_cast<std::size_t>(mWidth) * mHeight, false);
+}
+
+/**
+ * @note Nodes are allocated for the search window only.
+*/
+void pathfinders::DSLPF::initialize(Cell const& src, Cell const& dest) {
+    mNodeOrigin = { std::max(0, mBegin.x), std::max(0, mBegin.y) };
+    Cell nodeEnd = { std::min(mWidth - 1, mEnd.x), std::min(mHeight - 1, mEnd.y) };
+    mNodeWidth = nodeEnd.x - mNodeOrigin.x + 1;
+    mNodes.assign(static_cast<std::size_t>(mNodeWidth) * (nodeEnd.y - mNodeOrigin.y + 1), Node{ kInfinity, kInfinity });
+    mOpenList.clear();
+    mModifier = 0;
+    mSettledCount = 0;
+
+    mSrc = src;
+    mDest = dest;
+    mNodes[toNodeIndex(dest)].rhs = 0;
+    updateVertex(dest);
+
+    mIsInitialized = true;
+}
+
+pathfinders::DSLPF::Key pathfinders::DSLPF::calculateKey(Cell const& cell) const {
+    auto const& node = mNodes[toNodeIndex(cell)];
+    int distance = std::min(node.g, node.rhs);
+    if (distance >= kInfinity) return { kInfinity, kInfinity };
+    return { distance + std::abs(cell.x - mSrc.x) + std::abs(cell.y - mSrc.y) + mModifier, distance };
+}
+
+/**
+ * @return the one-step lookahead distance of `cell` i.e. the minimum over its successors of `g + 1`.
+*/
+int pathfinders::DSLPF::calculateRhs(Cell const& cell) const {
+    if (cell == mDest) return 0;
+
+    int rhs = kInfinity;
+    for (const auto& direction : kDirections) {
+        auto successor = cell + direction;
+        if (isUnblocked(cell, successor)) rhs = std::min(rhs, mNodes[toNodeIndex(successor)].g + 1);
+    }
+
+    return std::min(rhs, kInfinity);
+}
+
+void pathfinders::DSLPF::setG(Node& node, int g) {
+    if (node.g >= kInfinity && g < kInfinity) ++mSettledCount;
+    else if (node.g < kInfinity && g >= kInfinity) --mSettledCount;
+    node.g = g;
+}
+
+/**
+ * @note Outdated entries are left in the open list and skipped upon retrieval, see `getTopKey()`.
+*/
+void pathfinders::DSLPF::updateVertex(Cell const& cell) {
+    auto& node = mNodes[toNodeIndex(cell)];
+
+    if (node.g != node.rhs) {
+        node.key = calculateKey(cell);
+        node.isOpen = true;
+        mOpenList.push(Entry{ node.key, cell });
+    } else node.isOpen = false;
+}
+
+pathfinders::DSLPF::Key pathfinders::DSLPF::getTopKey() {
+    while (!mOpenList.empty()) {
+        auto const& top = mOpenList.top();
+        auto const& node = mNodes[toNodeIndex(top.cell)];
+        if (node.isOpen && node.key == top.key) return top.key;
+        mOpenList.pop();   // Outdated
+    }
+
+    return { kInfinity, kInfinity };
+}
+
+void pathfinders::DSLPF::computeShortestPath() {
+    while (true) {
+        auto topKey = getTopKey();
+        if (topKey.first >= kInfinity) break;
+
+        auto const& srcNode = mNodes[toNodeIndex(mSrc)];
+        if (!(topKey < calculateKey(mSrc)) && srcNode.rhs <= srcNode.g) break;
+
+        auto cell = mOpenList.pop().cell;
+        auto& node = mNodes[toNodeIndex(cell)];
+
+        // Priorities shifted by `mModifier` since insertion
+        auto key = calculateKey(cell);
+        if (topKey < key) {
+            node.key = key;
+            mOpenList.push(Entry{ key, cell });
+            continue;
+        }
+
+        ++mExpandedCount;
+        if (node.stamp != mSearchCount) {
+            if (node.g < kInfinity) ++mReexpandedCount;
+            node.stamp = mSearchCount;
+        }
+
+        if (node.g > node.rhs) {
+            // Overconsistent: settle the distance and propagate it
+            setG(node, node.rhs);
+            node.isOpen = false;
+
+            for (const auto& direction : kDirections) {
+                auto predecessor = cell + direction;
+                if (!isUnblocked(cell, predecessor) || predecessor == mDest) continue;
+
+                auto& predecessorNode = mNodes[toNodeIndex(predecessor)];
+                predecessorNode.rhs = std::min(predecessorNode.rhs, node.g + 1);
+                updateVertex(predecessor);
+            }
+        } else {
+            // Underconsistent: invalidate the distance, then recompute every estimate that relied on it
+            int g = node.g;
+            setG(node, kInfinity);
+
+            for (const auto& direction : kDirections) {
+                auto predecessor = cell + direction;
+                if (!isUnblocked(cell, predecessor) || predecessor == mDest) continue;
+
+                auto& predecessorNode = mNodes[toNodeIndex(predecessor)];
+                if (predecessorNode.rhs == g + 1) predecessorNode.rhs = calculateRhs(predecessor);
+                updateVertex(predecessor);
+            }
+
+            if (!(cell == mDest)) node.rhs = calculateRhs(cell);
+            updateVertex(cell);
+        }
+    }
+}
+
+/**
+ * @param path receives the resulting path in reverse order i.e. `path.back()` is `src` and `path.front()` is `dest`.
+ * @note The first search, or any search after the grid is resized, runs from scratch. Every subsequent one repairs the previous state.
+*/
+pathfinders::Status pathfinders::DSLPF::search(Cell const& src, Cell const& dest, std::vector<Cell>& path) {
+    path.clear();
+    mExpandedCount = mReexpandedCount = mReusedCount = 0;
+
+    fit();
+    if (!mWidth) return Status::kFailure;
+
+    if (!isValid(src)) return Status::kInvalidSrc;
+    if (!isValid(dest)) return Status::kInvalidDest;
+    if (!mGrid[src.y][src.x]) return Status::kBlockedSrc;
+    if (!mGrid[dest.y][dest.x]) return Status::kBlockedDest;
+    if (src == dest) return Status::kCoincidents;
+    if (mComponents != nullptr && !mComponents->isConnected(src, dest)) return Status::kFailure;
+
+    if (!++mSearchCount) ++mSearchCount;   // `0` is reserved for cells that have never been expanded
+
+    if (!mIsInitialized) initialize(src, dest);
+    else {
+        if (!(src == mSrc)) {
+            mModifier += std::abs(src.x - mSrc.x) + std::abs(src.y - mSrc.y);
+            mSrc = src;
+        }
+
+        if (!(dest == mDest)) {
+            auto prev = mDest;
+            mDest = dest;
+
+            mNodes[toNodeIndex(prev)].rhs = calculateRhs(prev);
+            updateVertex(prev);
+            mNodes[toNodeIndex(dest)].rhs = 0;
+            updateVertex(dest);
+        }
+    }
+
+    auto settledCount = mSettledCount;
+    computeShortestPath();
+    mReusedCount = settledCount > mReexpandedCount ? settledCount - mReexpandedCount : 0;
+
+    if (mNodes[toNodeIndex(src)].rhs >= kInfinity) return Status::kFailure;   // `g` of `src` itself is not required to be settled
+
+    // Descend the distances from `src`
+    for (auto curr = src; ; ) {
+        path.push_back(curr);
+        if (curr == dest) break;
+
+        auto next = curr;
+        int g = kInfinity;
+        for (const auto& direction : kDirections) {
+            auto successor = curr + direction;
+            if (isUnblocked(curr, successor) && mNodes[toNodeIndex(successor)].g < g) {
+                next = successor;
+                g = mNodes[toNodeIndex(successor)].g;
+            }
+        }
+
+        if (next == curr || path.size() > mNodes.size()) {
+            path.clear();
+            return Status::kFailure;
+        }
+        curr = next;
+    }
+
+    std::reverse(path.begin(), path.end());
+    return Status::kSuccess;
+}
+
+/**
+ * @brief Notify the planner that the collision level of `cell` has changed.
+*/
+void pathfinders::DSLPF::update(Cell const& cell) {
+    fit();
+    if (!mIsInitialized || !isValid(cell)) return;
+
+    if (!(cell == mDest)) mNodes[toNodeIndex(cell)].rhs = calculateRhs(cell);
+    updateVertex(cell);
+
+    for (const auto& direction : kDirections) {
+        auto neighbour = cell + direction;
+        if (!isValid(neighbour) || neighbour == mDest) continue;
+
+        mNodes[toNodeIndex(neighbour)].rhs = calculateRhs(neighbour);
+        updateVertex(neighbour);
+    }
+}
+
+/**
+ * @brief Mark `cell` as (un)blocked on top of the grid, e.g. when occupied by another entity.
+*/
+void pathfinders::DSLPF::setBlocked(Cell const& cell, bool isBlocked) {
+    fit();
+    if (cell.x < 0 || cell.x >= mWidth || cell.y < 0 || cell.y >= mHeight || mBlocked[toIndex(cell)] == isBlocked) return;   // Outside the search window still counts, should the window move
+
+    mBlocked[toIndex(cell)] = isBlocked;
+    update(cell);
+}
+
+void pathfinders::DSLPF::clear() {
+    mIsInitialized = false;
+    mWidth = mHeight = 0;
+    mNodes.clear();
+    mBlocked.clear();
+    mOpenList.clear();
+    mModifier = 0;
+    mSettledCount = 0;
+}
+
+
+pathfinders::PathService::PathService(std::vector<std::vector<int>> const& grid, std::size_t workerCount, Components const* components) : mGrid(grid), mComponents(components), mWorkerCount(workerCount) {}
+
+pathfinders::PathService::~PathService() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsStopping = true;
+    }
+    mCondition.notify_all();
+
+    for (auto& worker : mWorkers) if (worker.joinable()) worker.join();
+}
+
+/**
+ * @brief Take a new snapshot of the grid, discarding every request issued against the previous one.
+ * @note Workers are started on the first call rather than upon construction, which happens during static initialization.
+*/
+void pathfinders::PathService::synchronize() {
+    mSnapshot = std::make_shared<const Grid>(mGrid);
+    mFirstValidTicket = mNextTicket;
+    mResults.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPending.clear();
+        mCompleted.clear();
+        mCancelled.clear();
+    }
+
+    if (mWorkers.empty()) for (std::size_t i = 0; i < mWorkerCount; ++i) mWorkers.emplace_back(&PathService::work, this);
+}
+
+/**
+ * @return the ticket with which the result can later be retrieved, or `kInvalidTicket` if there is no grid to search.
+*/
+pathfinders::PathService::Ticket pathfinders::PathService::submit(Request const& request) {
+    if (mSnapshot == nullptr || mSnapshot->empty() || mWorkers.empty()) return kInvalidTicket;
+
+    auto ticket = mNextTicket++;
+
+    // Resolve unreachable requests immediately instead of occupying a worker
+    if (mComponents != nullptr && !mComponents->isConnected(request.src, request.dest)) {
+        mResults.emplace(ticket, Result{});
+        return ticket;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPending.push_back(Job{ ticket, request, mSnapshot });
+    }
+    mCondition.notify_one();
+
+    return ticket;
+}
+
+/**
+ * @brief Discard the request of `ticket` e.g. when it has been superseded. Its result, if any, will never be published.
+ * @note Pending requests are dropped before being searched.
+*/
+void pathfinders::PathService::cancel(Ticket ticket) {
+    if (ticket < mFirstValidTicket || mResults.erase(ticket)) return;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = std::find_if(mPending.begin(), mPending.end(), [&](Job const& job) { return job.ticket == ticket; });
+    if (it != mPending.end()) mPending.erase(it);
+    else mCancelled.insert(ticket);   // Either being searched or awaiting `collect()`
+}
+
+/**
+ * @brief Publish every result completed since the last call.
+*/
+void pathfinders::PathService::collect() {
+    std::vector<std::pair<Ticket, Result>> completed;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        completed.swap(mCompleted);
+        for (auto it = completed.begin(); it != completed.end(); ) {
+            if (mCancelled.erase(it->first) || it->first < mFirstValidTicket) it = completed.erase(it);
+            else ++it;
+        }
+    }
+
+    for (auto& [ticket, result] : completed) mResults.emplace(ticket, std::move(result));
+}
+
+/**
+ * @return the result of `ticket` if it has been published, which is then forgotten.
+*/
+std::optional<pathfinders::PathService::Result> pathfinders::PathService::retrieve(Ticket ticket) {
+    auto it = mResults.find(ticket);
+    if (it == mResults.end()) return std::nullopt;
+
+    auto result = std::move(it->second);
+    mResults.erase(it);
+    return result;
+}
+
+/**
+ * @brief The loop of a worker thread.
+ * @note Each worker owns its pathfinders, rebuilt whenever a request refers to a newer snapshot, so no search state is ever shared.
+ * @note Searches use JPS (JPS+ for 8-directional movement, whose precomputation is paid once per snapshot). Unreachable requests never get here, see `submit()`.
+*/
+void pathfinders::PathService::work() {
+    std::shared_ptr<const Grid> grid;
+    std::optional<JPSPF<Heuristic::kManhattan, MovementType::k4Directional, OpenListPolicy::kIndexedHeap>> pathfinder4;
+    std::optional<JPSPlusPF<>> pathfinder8;
+
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [&] { return mIsStopping || !mPending.empty(); });
+            if (mIsStopping) return;
+
+            job = std::move(mPending.front());
+            mPending.pop_front();
+        }
+
+        if (job.grid != grid) {
+            pathfinder4.reset();
+            pathfinder8.reset();
+            grid = job.grid;
+            pathfinder4.emplace(*grid);
+            pathfinder8.emplace(*grid);
+        }
+
+        Result result;
+        result.status = job.request.movementType == MovementType::k4Directional ? pathfinder4->search(job.request.src, job.request.dest, result.path) : pathfinder8->search(job.request.src, job.request.dest, result.path);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCompleted.emplace_back(job.ticket, std::move(result));
+    }
+}
+
+
+#define INSTANTIATE_(PF, M, P) \
+template class pathfinders::PF<pathfinders::Heuristic::kManhattan, pathfinders::MovementType::M, pathfinders::OpenListPolicy::P>;\
+template class pathfinders::PF<pathfinders::Heuristic::kChebyshev, pathfinders::MovementType::M, pathfinders::OpenListPolicy::P>;\
+template class pathfinders::PF<pathfinders::Heuristic::kOctile, pathfinders::MovementType::M, pathfinders::OpenListPolicy::P>;\
+template class pathfinders::PF<pathfinders::Heuristic::kEuclidean, pathfinders::MovementType::M, pathfinders::OpenListPolicy::P>;\
+template class pathfinders::PF<pathfinders::Heuristic::kConstantZero, pathfinders::MovementType::M, pathfinders::OpenListPolicy::P>;\
+template class pathfinders::PF<pathfinders::Heuristic::kContantInf, pathfinders::MovementType::M, pathfinders::OpenListPolicy::P>;
+
+#define INSTANTIATE(PF, M) \
+INSTANTIATE_(PF, M, kBinaryHeap)\
+INSTANTIATE_(PF, M, kIndexedHeap)
+
+INSTANTIATE(ASPF, k4Directional)
+INSTANTIATE(ASPF, k8Directional)
+INSTANTIATE(JPSPF, k4Directional)
+INSTANTIATE(JPSPF, k8Directional)
+INSTANTIATE(JPSPlusPF, k8Directional)
 
-template class pathfinders::ASPF<pathfinders::Heuristic::kManhattan, pathfinders::MovementType::k4Directional>;
-template class pathfinders::ASPF<pathfinders::Heuristic::kChebyshev, pathfinders::MovementType::k4Directional>;
-template class pathfinders::ASPF<pathfinders::Heuristic::kOctile, pathfinders::MovementType::k4Directional>;
-template class pathfinders::ASPF<pathfinders::Heuristic::kEuclidean, pathfinders::MovementType::k4Directional>;
-template class pathfinders::ASPF<pathfinders::Heuristic::kConstantZero, pathfinders::MovementType::k4Directional>;
-template class pathfinders::ASPF<pathfinders::Heuristic::kContantInf, pathfinders::MovementType::k4Directional>;
\ No newline at end of file
+#undef INSTANTIATE
+#undef INSTANTIATE_
@@ -0,0 +1,125 @@
+#include <auxiliaries.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include <SDL.h>
+
+
+/**
+ * @brief Queue a quad. Equivalent to `SDL_RenderCopyEx(renderer, texture, &srcRect, &destRect, angle, center, flip)` with `color` as color modulation, once flushed.
+ * @param layer a non-negative value allows the quad to be reordered by texture among quads of the same layer.
+*/
+void SpriteBatcher::draw(SDL_Texture* texture, SDL_Rect const& srcRect, SDL_Rect const& destRect, SDL_RendererFlip flip, double angle, SDL_Point const* center, SDL_Color color, int layer) {
+    if (texture == nullptr) return;
+    ++mStats.sprites;
+
+    if (layer == kOrderedLayer && (mQuads.empty() || mQuads.back().layer != kOrderedLayer || mQuads.back().texture != texture)) ++mRunCount;
+
+    std::array<SDL_FPoint, 4> corners = {{
+        { static_cast<float>(destRect.x), static_cast<float>(destRect.y) },
+        { static_cast<float>(destRect.x + destRect.w), static_cast<float>(destRect.y) },
+        { static_cast<float>(destRect.x + destRect.w), static_cast<float>(destRect.y + destRect.h) },
+        { static_cast<float>(destRect.x), static_cast<float>(destRect.y + destRect.h) },
+    }};
+
+    if (angle) {   // Clockwise around `center`, relative to `destRect`, as per `SDL_RenderCopyEx()`
+        SDL_FPoint pivot = center != nullptr ? SDL_FPoint{ static_cast<float>(destRect.x + center->x), static_cast<float>(destRect.y + center->y) } : SDL_FPoint{ destRect.x + destRect.w / 2.0f, destRect.y + destRect.h / 2.0f };
+        auto radians = angle * M_PI / 180;
+        auto cos = static_cast<float>(std::cos(radians));
+        auto sin = static_cast<float>(std::sin(radians));
+
+        for (auto& corner : corners) {
+            SDL_FPoint offset = { corner.x - pivot.x, corner.y - pivot.y };
+            corner = { pivot.x + offset.x * cos - offset.y * sin, pivot.y + offset.x * sin + offset.y * cos };
+        }
+    }
+
+    for (auto& corner : corners) corner = { std::round(corner.x * mScale.x + mOffset.x), std::round(corner.y * mScale.y + mOffset.y) };
+
+    mQuads.push_back({
+        texture,
+        { static_cast<float>(srcRect.x), static_cast<float>(srcRect.y), static_cast<float>(srcRect.w), static_cast<float>(srcRect.h) },
+        corners, flip, color, layer, mRunCount,
+    });
+}
+
+/**
+ * @brief Submit every queued quad to the current render target, one `SDL_RenderGeometry()` call per run of quads sharing a texture.
+*/
+void SpriteBatcher::flush(SDL_Renderer* renderer) {
+    if (mQuads.empty()) return;
+
+    mSortedIndices.resize(mQuads.size());
+    std::iota(mSortedIndices.begin(), mSortedIndices.end(), 0);
+    std::stable_sort(mSortedIndices.begin(), mSortedIndices.end(), [&](std::size_t first, std::size_t second) {
+        auto const& a = mQuads[first];
+        auto const& b = mQuads[second];
+        if (a.layer != b.layer) return a.layer < b.layer;
+        return a.layer == kOrderedLayer ? a.order < b.order : std::less<SDL_Texture*>()(a.texture, b.texture);
+    });
+
+    for (std::size_t begin = 0, end; begin < mSortedIndices.size(); begin = end) {
+        auto texture = mQuads[mSortedIndices[begin]].texture;
+        for (end = begin + 1; end < mSortedIndices.size() && mQuads[mSortedIndices[end]].texture == texture; ++end);
+
+        int textureWidth, textureHeight;
+        if (SDL_QueryTexture(texture, nullptr, nullptr, &textureWidth, &textureHeight) || !textureWidth || !textureHeight) continue;
+
+        mVertices.clear();
+        mIndices.clear();
+
+        for (auto i = begin; i < end; ++i) {
+            auto const& quad = mQuads[mSortedIndices[i]];
+
+            float u0 = quad.srcRect.x / textureWidth, u1 = (quad.srcRect.x + quad.srcRect.w) / textureWidth;
+            float v0 = quad.srcRect.y / textureHeight, v1 = (quad.srcRect.y + quad.srcRect.h) / textureHeight;
+            if (quad.flip & SDL_FLIP_HORIZONTAL) std::swap(u0, u1);
+            if (quad.flip & SDL_FLIP_VERTICAL) std::swap(v0, v1);
+
+            auto base = static_cast<int>(mVertices.size());
+            mVertices.push_back({ quad.corners[0], quad.color, { u0, v0 } });
+            mVertices.push_back({ quad.corners[1], quad.color, { u1, v0 } });
+            mVertices.push_back({ quad.corners[2], quad.color, { u1, v1 } });
+            mVertices.push_back({ quad.corners[3], quad.color, { u0, v1 } });
+            for (auto index : { 0, 1, 2, 0, 2, 3 }) mIndices.push_back(base + index);
+        }
+
+        SDL_RenderGeometry(renderer, texture, mVertices.data(), static_cast<int>(mVertices.size()), mIndices.data(), static_cast<int>(mIndices.size()));
+        ++mStats.batches;
+    }
+
+    mQuads.clear();
+    mRunCount = 0;
+}
+
+/**
+ * @brief Drop every queued quad without submitting it.
+*/
+void SpriteBatcher::clear() {
+    mQuads.clear();
+    mRunCount = 0;
+}
+
+/**
+ * @brief Map subsequently drawn quads from `(x, y)` to `(x * scale.x + offset.x, y * scale.y + offset.y)`.
+ * @note Quads already queued are unaffected.
+*/
+void SpriteBatcher::setTransform(SDL_FPoint const& offset, SDL_FPoint const& scale) {
+    mOffset = offset;
+    mScale = scale;
+}
+
+void SpriteBatcher::resetTransform() {
+    setTransform({ 0, 0 }, { 1, 1 });
+}
+
+/**
+ * @brief Apply the current transform to `rect`, e.g. for primitives that bypass the batcher.
+*/
+SDL_Rect SpriteBatcher::transform(SDL_Rect const& rect) const {
+    int x0 = std::round(rect.x * mScale.x + mOffset.x), y0 = std::round(rect.y * mScale.y + mOffset.y);
+    int x1 = std::round((rect.x + rect.w) * mScale.x + mOffset.x), y1 = std::round((rect.y + rect.h) * mScale.y + mOffset.y);
+    return { x0, y0, x1 - x0, y1 - y0 };
+}
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <optional>
 #include <filesystem>
+#include <memory>
 
 #include <SDL.h>
 
@@ -18,12 +19,33 @@ void tile::Data_Generic::setProperty(std::string const& key, std::string const&
     else it->second = property;
 }
 
+/**
+ * @brief Decode the image of a tileset from loaded XML data, without touching the renderer i.e. safe to call from any thread.
+ * @return `nullptr` on failure.
+*/
+SDL_Surface* tile::Data_Generic::decode(pugi::xml_document const& XMLTilesetData) {
+    auto source_a = XMLTilesetData.child("tileset").child("image").attribute("source"); if (source_a == nullptr) return nullptr;
+
+    std::filesystem::path path(source_a.as_string());
+    return IMG_Load_RW(globals::archive.open(config::path::asset / utils::cleanRelativePath(path)), 1);
+}
+
 /**
  * @brief Read data associated with a tileset from loaded XML data.
  * @note Also loads the `texture`.
  * @note Requires `document` to be successfully loaded from a XML file.
 */
 void tile::Data_Generic::load(pugi::xml_document const& XMLTilesetData, SDL_Renderer* renderer) {
+    load(XMLTilesetData, decode(XMLTilesetData), renderer);
+}
+
+/**
+ * @brief Read data associated with a tileset from loaded XML data, creating the `texture` from `surface` as decoded by `decode()`.
+ * @note Takes ownership of `surface`.
+*/
+void tile::Data_Generic::load(pugi::xml_document const& XMLTilesetData, SDL_Surface* surface, SDL_Renderer* renderer) {
+    std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> surfaceGuard(surface, SDL_FreeSurface);
+
     // Parse nodes
     auto tileset_n = XMLTilesetData.child("tileset"); if (tileset_n.empty()) return;
     auto image_n = tileset_n.child("image"); if (image_n.empty()) return;
@@ -44,10 +66,7 @@ void tile::Data_Generic::load(pugi::xml_document const& XMLTilesetData, SDL_Rend
     };
 
     // Texture
-    auto source_a = image_n.attribute("source"); if (source_a == nullptr) return;
-
-    std::filesystem::path path(source_a.as_string());
-    texture = IMG_LoadTexture(renderer, (config::path::asset / utils::cleanRelativePath(path)).string().c_str());   // Should also check whether path exists
+    if (surface != nullptr) texture = SDL_CreateTextureFromSurface(renderer, surface);
 }
 
 void tile::Data_Generic::clear() {
@@ -72,7 +91,7 @@ void tile::Data_TilelayerTileset::load(json const& JSONTileLayerData, SDL_Render
     std::filesystem::path xmlPath(source_j.value());
 
     pugi::xml_document document;
-    pugi::xml_parse_result result = document.load_file((config::path::asset_tiled / utils::cleanRelativePath(xmlPath)).c_str());   // All tilesets should be located in "assets/.tiled/"
+    pugi::xml_parse_result result = utils::fetch(config::path::asset_tiled / utils::cleanRelativePath(xmlPath), document);   // All tilesets should be located in "assets/.tiled/"
     if (!result) return;   // Should be replaced with `result.status` or `pugi::xml_parse_status`
 
     Data_Generic::load(document, renderer);
@@ -211,7 +230,14 @@ void tile::Data_EntityTileset::Data_Animation::load(pugi::xml_node const& XMLAni
  * @note Use `std::strcmp()` instead of `std::string()` in C-string comparison for slight performance gains.
 */
 void tile::Data_EntityTileset::load(pugi::xml_document const& XMLTilesetData, SDL_Renderer* renderer) {
-    Data_Generic::load(XMLTilesetData, renderer);
+    load(XMLTilesetData, decode(XMLTilesetData), renderer);
+}
+
+/**
+ * @note Takes ownership of `surface`, see `Data_Generic::decode()`.
+*/
+void tile::Data_EntityTileset::load(pugi::xml_document const& XMLTilesetData, SDL_Surface* surface, SDL_Renderer* renderer) {
+    Data_Generic::load(XMLTilesetData, surface, renderer);
 
     auto tileset_n = XMLTilesetData.child("tileset"); if (tileset_n.empty()) return;
     auto properties_n = tileset_n.child("properties"); if (properties_n.empty()) return;
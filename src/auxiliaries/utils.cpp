@@ -4,7 +4,6 @@
 #include <array>
 #include <cmath>
 #include <functional>
-#include <fstream>
 #include <iomanip>
 #include <vector>
 #include <sstream>
@@ -154,6 +153,34 @@ std::string utils::dtos(const double d, unsigned int precision) {
     return oss.str();
 }
 
+/**
+ * @brief Decode the UTF-8 code point starting at byte `i` of `s`, then advance `i` past it.
+ * @note Malformed sequences decode to U+FFFD, consuming a single byte, so that decoding always progresses.
+*/
+Uint32 utils::nextCodepoint(std::string_view s, std::size_t& i) {
+    static constexpr Uint32 kReplacementCharacter = 0xfffd;
+
+    auto lead = static_cast<unsigned char>(s[i++]);
+    if (lead < 0x80) return lead;
+
+    int continuationCount;
+    Uint32 codepoint;
+    if ((lead & 0xe0) == 0xc0) { continuationCount = 1; codepoint = lead & 0x1f; }
+    else if ((lead & 0xf0) == 0xe0) { continuationCount = 2; codepoint = lead & 0x0f; }
+    else if ((lead & 0xf8) == 0xf0) { continuationCount = 3; codepoint = lead & 0x07; }
+    else return kReplacementCharacter;
+
+    if (i + continuationCount > s.size()) return kReplacementCharacter;
+    for (int j = 0; j < continuationCount; ++j) {
+        auto continuation = static_cast<unsigned char>(s[i + j]);
+        if ((continuation & 0xc0) != 0x80) return kReplacementCharacter;
+        codepoint = (codepoint << 6) | (continuation & 0x3f);
+    }
+
+    i += continuationCount;
+    return codepoint;
+}
+
 SDL_Point utils::fpttopt(SDL_FPoint const& fpt) {
     return { utils::ftoi(fpt.x), utils::ftoi(fpt.y) };
 }
@@ -380,15 +407,27 @@ std::string utils::base64Decode(std::string const& s) {
 }
 
 /**
- * @brief Read a JSON file.
+ * @brief Read a JSON file, through `globals::archive`.
 */
 void utils::fetch(std::filesystem::path const& path, json& data) {
-    std::ifstream file;
-    file.open(path);
-    if (!file.is_open()) return;
+    std::vector<char> buffer;
+    if (!globals::archive.read(path, buffer)) return;
+
+    data = json::parse(buffer.begin(), buffer.end());
+}
+
+/**
+ * @brief Read a XML file, through `globals::archive`.
+*/
+pugi::xml_parse_result utils::fetch(std::filesystem::path const& path, pugi::xml_document& document) {
+    std::vector<char> buffer;
+    if (!globals::archive.read(path, buffer)) {
+        pugi::xml_parse_result result;
+        result.status = pugi::status_file_not_found;
+        return result;
+    }
 
-    data = json::parse(file);
-    file.close();
+    return document.load_buffer(buffer.data(), buffer.size());
 }
 
 /**
@@ -11,191 +11,233 @@
 #include <auxiliaries.hpp>
 
 
-void IngameDialogueBox::BMPFont::Map::insert(char c, Data_Glyph_Storage const& data) {
-    mGlyphDataUMap.insert(std::make_pair(c, data));
-}
+/**
+ * @brief Rasterize printable ASCII of `font` upfront.
+ * @note Takes ownership of `font`.
+*/
+IngameDialogueBox::BMPFont::BMPFont(ComponentPreset const& preset, TTF_Font* font) : mFont(font), mPreset(preset) {
+    if (mFont == nullptr) return;
+    mGlyphHeight = TTF_FontHeight(mFont);
 
-IngameDialogueBox::BMPFont::Data_Glyph_Query IngameDialogueBox::BMPFont::Map::operator[](char c) const {
-    Data_Glyph_Query data;
+    for (Uint32 codepoint = '!'; codepoint <= '~'; ++codepoint) registerGlyph(codepoint);
+}
 
-    // Same for every glyph
-    data.srcRect.y = 0;
-    data.srcRect.h = mGlyphHeight;
+IngameDialogueBox::BMPFont::~BMPFont() {
+    clearPages();
 
-    auto it = mGlyphDataUMap.find(c);
-    if (it != mGlyphDataUMap.end()) {
-        data.srcRect.w = it->second.width;
-        data.advance = it->second.advance;
+    if (mFont != nullptr) {
+        TTF_CloseFont(mFont);
+        mFont = nullptr;
     }
+}
 
-    // The sum of all "previous" glyphWidths
-    data.srcRect.x = 0;
-    for (const auto& pair : mGlyphDataUMap) {
-        if (pair.first >= c) break;
-        data.srcRect.x += pair.second.width;
-    }
+/**
+ * @brief Lay out `content`, a UTF-8 string, within a region of `size`, wrapping lines and starting a new screen whenever the region is full.
+ * @note Pages used by the layout are pinned until `release()` is called with it.
+*/
+IngameDialogueBox::BMPFont::Layout IngameDialogueBox::BMPFont::layout(std::string const& content, SDL_Point const& size) {
+    Layout layout;
+    SDL_Point origin = { 0, 0 };
+    std::size_t screenBegin = 0;
+
+    auto newScreen = [&]() {
+        origin = { 0, 0 };
+        screenBegin = layout.quads.size();
+    };
 
-    return data;
-}
+    auto endOfLine = [&]() {
+        origin.x = 0;
+        origin.y += mGlyphHeight + mSpacing.y;
+        if (origin.y + mGlyphHeight > size.y) newScreen();
+    };
 
+    for (std::size_t i = 0; i < content.size();) {
+        auto codepoint = utils::nextCodepoint(content, i);
 
-IngameDialogueBox::BMPFont::BMPFont(ComponentPreset const& preset) : mPreset(preset) {}
+        switch (codepoint) {
+            case ' ':
+                origin.x += mGlyphHeight / 2 + mSpacing.x;
+                break;
 
-IngameDialogueBox::BMPFont::~BMPFont() {
-    // `~Map()` automatically called
-    if (mTexture != nullptr) {
-        SDL_DestroyTexture(mTexture);
-        mTexture = nullptr;
-    }
-}
+            case '\n':
+                endOfLine();
+                break;
 
-void IngameDialogueBox::BMPFont::load(TTF_Font* font) {
-    mSrcSize.x = 0;
-    mSrcSize.y = TTF_FontHeight(font);
-    mSrcRectsMap.setGlyphHeight(mSrcSize.y);
+            case '\0':
+                newScreen();
+                break;
 
-    const std::string chars = getChars();
-    for (const auto& c : chars) registerCharToMap(font, c);
+            default: {
+                auto glyph = getGlyph(codepoint);
+                if (glyph == nullptr || !glyph->srcRect.w) break;
 
-    if (mTexture != nullptr) SDL_DestroyTexture(mTexture);
-    mTexture = SDL_CreateTexture(globals::renderer, SDL_PixelFormatEnum::SDL_PIXELFORMAT_RGBA32, SDL_TextureAccess::SDL_TEXTUREACCESS_TARGET, mSrcSize.x, mSrcSize.y);
+                if (origin.x + glyph->srcRect.w > size.x) endOfLine();
+                layout.quads.push_back({ glyph->pageIndex, glyph->srcRect, { origin.x, origin.y, glyph->srcRect.w, glyph->srcRect.h } });
+                origin.x += glyph->advance + mSpacing.x;
 
-    auto cachedRenderTarget = SDL_GetRenderTarget(globals::renderer);
-    SDL_SetRenderTarget(globals::renderer, mTexture);
-    for (const auto& c : chars) registerCharToTexture(font, c);
-    SDL_SetRenderTarget(globals::renderer, cachedRenderTarget);
-}
+                if (std::find(layout.pageIndices.begin(), layout.pageIndices.end(), glyph->pageIndex) == layout.pageIndices.end()) {
+                    layout.pageIndices.push_back(glyph->pageIndex);
+                    ++mPages[glyph->pageIndex].pinCount;
+                }
+                break;
+            }
+        }
 
-void IngameDialogueBox::BMPFont::setRenderTarget(SDL_Texture*& targetTexture) {
-    mTargetTexture = targetTexture;
-    SDL_QueryTexture(mTargetTexture, nullptr, nullptr, &mTargetTextureSize.x, &mTargetTextureSize.y);
+        layout.steps.push_back({ layout.quads.size(), screenBegin });
+    }
 
-    clear();
+    return layout;
 }
 
 /**
- * @brief Render char `c` to `texture` in common dialogue text style.
+ * @brief Unpin the pages used by `layout`, which should not be rendered afterwards.
 */
-void IngameDialogueBox::BMPFont::render(char c) const {
-    static auto endOfLine = [&]() {
-        mGlyphOrigin.x = 0;
-        mGlyphOrigin.y += mSrcSize.y + mSpacing.y;
-    };
-
-    switch (c) {
-        case ' ':
-            mGlyphOrigin.x += mSrcSize.y / 2 + mSpacing.x;
-            return;
-
-        case '\n':
-            endOfLine();
-            return;
-
-        case '\0':
-            clear();
-            return;
+void IngameDialogueBox::BMPFont::release(Layout& layout) {
+    for (auto pageIndex : layout.pageIndices) if (pageIndex < mPages.size() && mPages[pageIndex].pinCount) --mPages[pageIndex].pinCount;
+    layout.pageIndices.clear();
+}
 
-        default: break;
+/**
+ * @brief Draw the quads of the screen that `step` is on, revealed so far, offset by `origin`, in one batch per page.
+ * @note The cost is bounded by the size of a screen, not by the length of the content.
+*/
+void IngameDialogueBox::BMPFont::render(Layout const& layout, Step const& step, SDL_Point const& origin) const {
+    for (auto i = step.screenBegin; i < step.quadCount; ++i) {
+        auto const& quad = layout.quads[i];
+        SDL_Rect destRect = { origin.x + quad.destRect.x, origin.y + quad.destRect.y, quad.destRect.w, quad.destRect.h };
+        globals::batcher.draw(mPages[quad.pageIndex].texture, quad.srcRect, destRect);
     }
 
-    const auto data = mSrcRectsMap[c];
-    if (!data.srcRect.w) return;
-
-    SDL_Rect chrDestRect;
-    chrDestRect.w = data.srcRect.w;
-    chrDestRect.h = data.srcRect.h;
+    globals::batcher.flush(globals::renderer);
+}
 
-    if (mGlyphOrigin.x + chrDestRect.w > mTargetTextureSize.x) { if (mGlyphOrigin.y + chrDestRect.h > mTargetTextureSize.y) clear(); else endOfLine(); }
+/**
+ * @brief Retrieve the glyph of `codepoint`, rasterizing it first if absent from the atlas.
+ * @note `O(1)` time complexity, save for rasterization.
+*/
+IngameDialogueBox::BMPFont::Glyph const* IngameDialogueBox::BMPFont::getGlyph(Uint32 codepoint) {
+    if (mFont == nullptr) return nullptr;
 
-    chrDestRect.x = mGlyphOrigin.x;
-    chrDestRect.y = mGlyphOrigin.y;
-    mGlyphOrigin.x += data.advance + mSpacing.x;
+    auto& glyph = findGlyph(codepoint);
+    if (!glyph.has_value()) registerGlyph(codepoint);
+    if (!glyph.has_value()) return nullptr;
 
-    auto cachedRenderTarget = SDL_GetRenderTarget(globals::renderer);
-    SDL_SetRenderTarget(globals::renderer, mTargetTexture);
-    SDL_RenderCopy(globals::renderer, mTexture, &data.srcRect, &chrDestRect);
-    SDL_SetRenderTarget(globals::renderer, cachedRenderTarget);
+    if (glyph->srcRect.w) mPages[glyph->pageIndex].lastUsed = ++mUseCount;
+    return &glyph.value();
 }
 
-void IngameDialogueBox::BMPFont::clear() const {
-    auto cachedRenderTarget = SDL_GetRenderTarget(globals::renderer);
-    SDL_SetRenderTarget(globals::renderer, mTargetTexture);
-    utils::setRendererDrawColor(globals::renderer, mPreset.backgroundColor);
-    SDL_RenderClear(globals::renderer);
-    SDL_SetRenderTarget(globals::renderer, cachedRenderTarget);
-
-    mGlyphOrigin = { 0, 0 };
+std::optional<IngameDialogueBox::BMPFont::Glyph>& IngameDialogueBox::BMPFont::findGlyph(Uint32 codepoint) {
+    return codepoint < kASCIICount ? mASCIIGlyphs[codepoint] : mGlyphs[codepoint];
 }
 
 /**
- * @brief Retrieve all supported chars.
- * @note Must be ORDERED for `Map` to work.
+ * @see https://freetype.sourceforge.net/freetype2/docs/tutorial/step2.html
 */
-std::string IngameDialogueBox::BMPFont::getChars() const {
-    std::string chars;
-    const std::string symbols = "!?#%^/&*()-+,.:;`\\_=<>@\"\'$[]{}";
-    chars.reserve(26 * 2 + 10 + symbols.size());
+void IngameDialogueBox::BMPFont::registerGlyph(Uint32 codepoint) {
+    auto& glyph = findGlyph(codepoint);
+    glyph = Glyph{ 0, { 0, 0, 0, 0 }, 0 };
+    if (TTF_GlyphIsProvided32(mFont, codepoint) == 0) return;
 
-    for (char c = 'a'; c <= 'z'; ++c) chars += c;
-    for (char c = 'A'; c <= 'Z'; ++c) chars += c;
-    for (char c = '0'; c <= '9'; ++c) chars += c;
-    chars.append(symbols);
+    // Query glyph advance i.e. distance between 2 adjacent origins
+    TTF_GlyphMetrics32(mFont, codepoint, nullptr, nullptr, nullptr, nullptr, &glyph->advance);
 
-    std::sort(chars.begin(), chars.end());   // Really, really, really important!
+    SDL_Surface* surface = sTextRenderMethod(mFont, codepoint, mPreset.textColor, mPreset.backgroundColor);
+    if (surface == nullptr) return;
+    SDL_Surface* convertedSurface = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(surface);
+    if (convertedSurface == nullptr) return;
 
-    return chars;
+    SDL_Point origin;
+    auto pageIndex = allocate({ convertedSurface->w, convertedSurface->h }, origin);   // Eviction leaves `glyph` intact, since it is not in any page yet
+
+    if (pageIndex.has_value()) {
+        glyph->pageIndex = pageIndex.value();
+        glyph->srcRect = { origin.x, origin.y, convertedSurface->w, convertedSurface->h };
+        SDL_UpdateTexture(mPages[pageIndex.value()].texture, &glyph->srcRect, convertedSurface->pixels, convertedSurface->pitch);
+        mPages[pageIndex.value()].codepoints.push_back(codepoint);
+    }
+
+    SDL_FreeSurface(convertedSurface);
 }
 
 /**
- * @see https://freetype.sourceforge.net/freetype2/docs/tutorial/step2.html
+ * @brief Reserve a region of `size` on the page being filled, opening a new page or recycling the least recently used unpinned one as necessary.
 */
-void IngameDialogueBox::BMPFont::registerCharToMap(TTF_Font* font, char c) {
-    if (TTF_GlyphIsProvided32(font, c) == 0) return;
+std::optional<std::size_t> IngameDialogueBox::BMPFont::allocate(SDL_Point const& size, SDL_Point& origin) {
+    static constexpr int kPageSize = config::components::dialogue_box::atlasPageSize;
+    if (size.x > kPageSize || size.y > kPageSize) return std::nullopt;
+
+    auto tryAllocate = [&](std::size_t pageIndex) {
+        auto& page = mPages[pageIndex];
+        if (page.shelfOrigin.x + size.x > kPageSize) {   // Start a new shelf
+            page.shelfOrigin = { 0, page.shelfOrigin.y + page.shelfHeight };
+            page.shelfHeight = 0;
+        }
+        if (page.shelfOrigin.y + size.y > kPageSize) return false;
+
+        origin = page.shelfOrigin;
+        page.shelfOrigin.x += size.x;
+        page.shelfHeight = std::max(page.shelfHeight, size.y);
+        return true;
+    };
 
-    Data_Glyph_Storage data;
+    if (mCurrPageIndex < mPages.size() && tryAllocate(mCurrPageIndex)) return mCurrPageIndex;
 
-    // Query glyph width
-    SDL_Surface* surface = sTextRenderMethod(font, c, mPreset.textColor, mPreset.backgroundColor);
-    data.width = surface->w;
-    SDL_FreeSurface(surface);
+    auto it = std::min_element(mPages.begin(), mPages.end(), [](Page const& first, Page const& second) {
+        if (!first.pinCount != !second.pinCount) return !first.pinCount;   // Unpinned first
+        return first.lastUsed < second.lastUsed;
+    });
 
-    // Query glyph advance i.e. distance between 2 adjacent origins
-    TTF_GlyphMetrics32(font, c, nullptr, nullptr, nullptr, nullptr, &data.advance);
+    if (mPages.size() < config::components::dialogue_box::atlasMaxPageCount || it == mPages.end() || it->pinCount) {
+        Page page;
+        page.texture = SDL_CreateTexture(globals::renderer, SDL_PixelFormatEnum::SDL_PIXELFORMAT_RGBA32, SDL_TextureAccess::SDL_TEXTUREACCESS_STATIC, kPageSize, kPageSize);
+        if (page.texture == nullptr) return std::nullopt;
+        mPages.push_back(page);
+        mCurrPageIndex = mPages.size() - 1;
+    } else {
+        mCurrPageIndex = it - mPages.begin();
+        evictPage(mCurrPageIndex);
+    }
 
-    mSrcRectsMap.insert(c, data);
-    mSrcSize.x += data.width;
+    if (tryAllocate(mCurrPageIndex)) return mCurrPageIndex;
+    return std::nullopt;
 }
 
-void IngameDialogueBox::BMPFont::registerCharToTexture(TTF_Font* font, char c) const {
-    SDL_Surface* surface = sTextRenderMethod(font, c, mPreset.textColor, mPreset.backgroundColor);
-    if (surface == nullptr) return;
+/**
+ * @brief Forget every glyph residing in the page at `pageIndex`, so that it could be reused.
+*/
+void IngameDialogueBox::BMPFont::evictPage(std::size_t pageIndex) {
+    auto& page = mPages[pageIndex];
+    for (auto codepoint : page.codepoints) {
+        if (codepoint < kASCIICount) mASCIIGlyphs[codepoint] = std::nullopt;
+        else mGlyphs.erase(codepoint);
+    }
 
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(globals::renderer, surface);
-    SDL_FreeSurface(surface);
+    page.codepoints.clear();
+    page.shelfOrigin = { 0, 0 };
+    page.shelfHeight = 0;
+    page.lastUsed = 0;
+}
 
-    auto srcRect = mSrcRectsMap[c].srcRect;
-    SDL_RenderCopy(globals::renderer, texture, nullptr, &srcRect);
-    SDL_DestroyTexture(texture);
+void IngameDialogueBox::BMPFont::clearPages() {
+    for (auto& page : mPages) if (page.texture != nullptr) SDL_DestroyTexture(page.texture);
+    mPages.clear();
+    mCurrPageIndex = 0;
 }
 
 
-IngameDialogueBox::IngameDialogueBox(SDL_FPoint const& center, ComponentPreset const& preset) : GenericComponent<IngameDialogueBox>(center, preset), GenericBoxComponent<IngameDialogueBox>(center, preset), mBMPFont(preset) {}
+IngameDialogueBox::IngameDialogueBox(SDL_FPoint const& center, ComponentPreset const& preset) : GenericComponent<IngameDialogueBox>(center, preset), GenericBoxComponent<IngameDialogueBox>(center, preset) {}
 
 IngameDialogueBox::~IngameDialogueBox() {
-    if (mTextTexture != nullptr) {
-        SDL_DestroyTexture(mTextTexture);
-        mTextTexture = nullptr;
-    }
-    if (mFont != nullptr) {
-        TTF_CloseFont(mFont);
-        mFont = nullptr;
-    }
+    if (mBMPFont != nullptr) for (auto& dialogue : mDialogues) mBMPFont->release(dialogue.layout);
 }
 
 void IngameDialogueBox::render() const {
     GenericBoxComponent<IngameDialogueBox>::render();
-    if (mStatus == Status::kUpdateInProgress) mBMPFont.render(mContents.front()[mCurrProgress]);
-    SDL_RenderCopy(globals::renderer, mTextTexture, nullptr, &mTextDestRect);
+    if (mStatus == Status::kInactive || mDialogues.empty()) return;
+
+    auto const& layout = mDialogues.front().layout;
+    if (mCurrProgress < layout.steps.size()) mBMPFont->render(layout, layout.steps[mCurrProgress], { mTextDestRect.x, mTextDestRect.y });
 }
 
 void IngameDialogueBox::onWindowChange() {
@@ -209,16 +251,27 @@ void IngameDialogueBox::onWindowChange() {
         mBoxDestRect.h - 2 * destOffset,
     };
 
-    if (mTextTexture != nullptr) SDL_DestroyTexture(mTextTexture);
-    mTextTexture = SDL_CreateTexture(globals::renderer, SDL_PixelFormatEnum::SDL_PIXELFORMAT_RGBA32, SDL_TextureAccess::SDL_TEXTUREACCESS_TARGET, mTextDestRect.w, mTextDestRect.h);
+    // Layouts pin pages of the font they were computed with, hence they must be recomputed should the font or region change
+    if (mBMPFont != nullptr) for (auto& dialogue : mDialogues) mBMPFont->release(dialogue.layout);
+    loadBMPFont(getFontSize(sDestSize));
+    for (auto& dialogue : mDialogues) dialogue.layout = mBMPFont->layout(dialogue.content, { mTextDestRect.w, mTextDestRect.h });   // Progress is retained, being counted in code points
+}
 
-    if (mFont != nullptr) TTF_CloseFont(mFont);
-    mFont = TTF_OpenFont(sFontPath.generic_string().c_str(), getFontSize(sDestSize));
+/**
+ * @brief Switch to the font of `fontSize`, reusing a previously built one if possible, then drop the least recently used fonts beyond `config::components::dialogue_box::retainedFontCount`.
+*/
+void IngameDialogueBox::loadBMPFont(int fontSize) {
+    auto it = mBMPFonts.find(fontSize);
+    if (it == mBMPFonts.end()) it = mBMPFonts.emplace(fontSize, std::make_unique<BMPFont>(kPreset, TTF_OpenFontRW(globals::archive.open(sFontPath), 1, fontSize))).first;
+
+    mBMPFont = it->second.get();
+    mBMPFontSizes.erase(std::remove(mBMPFontSizes.begin(), mBMPFontSizes.end(), fontSize), mBMPFontSizes.end());
+    mBMPFontSizes.push_back(fontSize);
 
-    mBMPFont.clear();
-    mBMPFont.load(mFont);
-    mBMPFont.setRenderTarget(mTextTexture);
-    if (mStatus == Status::kUpdateInProgress) for (unsigned short int progress = 0; progress <= mCurrProgress; ++progress) mBMPFont.render(mContents.front()[progress]);   // Retain progress
+    while (mBMPFontSizes.size() > config::components::dialogue_box::retainedFontCount) {
+        mBMPFonts.erase(mBMPFontSizes.front());
+        mBMPFontSizes.pop_front();
+    }
 }
 
 void IngameDialogueBox::handleKeyBoardEvent(SDL_Event const& event) {
@@ -260,7 +313,7 @@ void IngameDialogueBox::handleSFX() const {
 void IngameDialogueBox::updateProgress() {
     switch (mStatus) {
         case Status::kUpdateInProgress:
-            if (mCurrProgress == static_cast<unsigned short int>(mContents.front().size()) - 1) mStatus = Status::kUpdateComplete;
+            if (mCurrProgress + 1 >= mDialogues.front().layout.steps.size()) mStatus = Status::kUpdateComplete;
             else ++mCurrProgress;
             break;
 
@@ -275,7 +328,7 @@ void IngameDialogueBox::updateProgress() {
 void IngameDialogueBox::enqueueContent(std::string const& content) {
     if (mStatus != Status::kInactive || content.empty()) return;
 
-    mContents.push(content);
+    enqueue(content);
 
     mCurrProgress = 0;
     mStatus = Status::kUpdateInProgress;
@@ -285,7 +338,8 @@ void IngameDialogueBox::enqueueContent(std::string const& content) {
 void IngameDialogueBox::enqueueContents(std::vector<std::string> const& contents) {
     if (mStatus != Status::kInactive || mDelayCounter) return;
 
-    for (const auto& content : contents) if (!content.empty()) mContents.push(content);
+    for (const auto& content : contents) if (!content.empty()) enqueue(content);
+    if (mDialogues.empty()) return;
 
     mCurrProgress = 0;
     mDelayCounter = sDelayCounterLimit;   // Reset
@@ -293,6 +347,13 @@ void IngameDialogueBox::enqueueContents(std::vector<std::string> const& contents
     globals::state = GameState::kIngameDialogue;
 }
 
+/**
+ * @brief Lay out `content` once, ahead of being revealed.
+*/
+void IngameDialogueBox::enqueue(std::string const& content) {
+    mDialogues.push_back({ content, mBMPFont->layout(content, { mTextDestRect.w, mTextDestRect.h }) });
+}
+
 int IngameDialogueBox::getFontSize(const double destSize) {
     // int size = static_cast<int>(destSize * 0.33);   // Accommodate as needed
 
@@ -309,10 +370,10 @@ int IngameDialogueBox::getFontSize(const double destSize) {
 void IngameDialogueBox::close() {
     if (mStatus != Status::kUpdateComplete) return;
 
-    mBMPFont.clear();
-    mContents.pop();
+    mBMPFont->release(mDialogues.front().layout);
+    mDialogues.pop_front();
 
-    if (!mContents.empty()) {
+    if (!mDialogues.empty()) {
         mCurrProgress = 0;
         mStatus = Status::kUpdateInProgress;
     } else {
@@ -323,10 +384,7 @@ void IngameDialogueBox::close() {
 
 void IngameDialogueBox::skip() {
     if (mStatus != Status::kUpdateInProgress) return;
-
-    const auto prevProgress = mCurrProgress;
-    mCurrProgress = static_cast<unsigned short int>(mContents.front().size()) - 1;
-    for (auto progress = prevProgress; progress < mCurrProgress; ++progress) mBMPFont.render(mContents.front()[progress]);
+    mCurrProgress = mDialogues.front().layout.steps.size() - 1;
 }
 
 
@@ -10,15 +10,15 @@ ExitText::ExitText(SDL_FPoint const& center, ComponentPreset const& preset, std:
 
 void ExitText::deinitialize() {
     Singleton<ExitText>::deinitialize();
-    if (sFont != nullptr) {
-        TTF_CloseFont(sFont);
-        sFont = nullptr;
-    }
+    releaseGlyphAtlas();
 }
 
 void ExitText::render() const {
     if (!mCurrProgress) return;
-    GenericTextComponent<ExitText>::render();
+
+    auto color = kPreset.textColor;
+    color.a = color.a * mTextAlpha / SDL_ALPHA_OPAQUE;
+    renderText(color);
 }
 
 void ExitText::onWindowChange() {
@@ -29,6 +29,7 @@ void ExitText::onWindowChange() {
 void ExitText::handleKeyBoardEvent(SDL_Event const& event) {
     if (event.key.keysym.sym != ~config::Key::kExit || event.type != SDL_KEYDOWN) {
         // Reset
+        if (mCurrProgress) invalidate(mTextDestRect);
         mCurrProgress = 0;
         return;
     }
@@ -43,14 +44,15 @@ void ExitText::handleKeyBoardEvent(SDL_Event const& event) {
 }
 
 /**
- * @brief Set transparency of `textTexture`.
+ * @brief Set transparency of the text.
  * @see <src/components/generic-progress-bar.cpp> GenericProgressBarComponent<T>::updateAnimation()
 */
 void ExitText::registerProgress() {
     auto eq = [](double progress) {
         return std::sqrt(1.0 - pow(progress - 1.0, 2));
     };
-    SDL_SetTextureAlphaMod(mTextTexture, SDL_ALPHA_OPAQUE * eq(mCurrProgress));
+    mTextAlpha = SDL_ALPHA_OPAQUE * eq(mCurrProgress);
+    invalidate(mTextDestRect);
 }
 
 
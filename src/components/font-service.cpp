@@ -0,0 +1,64 @@
+#include <components.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <tuple>
+
+#include <SDL_ttf.h>
+
+#include <auxiliaries.hpp>
+
+
+/**
+ * @brief Retrieve the atlas of the font at `path`, at `size` and `style`, opening the font if no component currently uses it.
+ * @note Every successful call should be paired with a call to `release()`.
+*/
+GlyphAtlas* FontService::acquire(std::filesystem::path const& path, int size, int style) {
+    auto key = std::make_tuple(path.generic_string(), size, style);
+    auto it = mAtlases.find(key);
+
+    if (it == mAtlases.end()) {
+        TTF_Font* font = TTF_OpenFontRW(globals::archive.open(path), 1, size);
+        if (font == nullptr) return nullptr;
+        TTF_SetFontStyle(font, style);
+        TTF_SetFontKerning(font, 1);
+
+        it = mAtlases.emplace(key, Entry{ std::make_unique<GlyphAtlas>(font), 0 }).first;
+    }
+
+    ++it->second.referenceCount;
+    return it->second.atlas.get();
+}
+
+/**
+ * @brief Give up a reference obtained from `acquire()`. An unreferenced atlas is kept for later reuse, until evicted by more recently released ones.
+*/
+void FontService::release(GlyphAtlas* atlas) {
+    if (atlas == nullptr) return;
+
+    auto it = std::find_if(mAtlases.begin(), mAtlases.end(), [&](auto const& pair) { return pair.second.atlas.get() == atlas; });   // Linear, but there are only ever a handful of atlases
+    if (it == mAtlases.end() || !it->second.referenceCount) return;
+    if (--it->second.referenceCount) return;
+
+    it->second.lastReleased = ++mReleaseCount;
+    evictUnreferenced();
+}
+
+/**
+ * @brief Destroy the least recently released atlases, along with their fonts, until at most `config::components::font_service::retainedAtlasCount` unreferenced ones remain.
+*/
+void FontService::evictUnreferenced() {
+    while (true) {
+        std::size_t unreferencedCount = 0;
+        auto oldest = mAtlases.end();
+
+        for (auto it = mAtlases.begin(); it != mAtlases.end(); ++it) {
+            if (it->second.referenceCount) continue;
+            ++unreferencedCount;
+            if (oldest == mAtlases.end() || it->second.lastReleased < oldest->second.lastReleased) oldest = it;
+        }
+
+        if (unreferencedCount <= config::components::font_service::retainedAtlasCount) return;
+        mAtlases.erase(oldest);
+    }
+}
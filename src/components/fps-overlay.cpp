@@ -10,10 +10,7 @@ FPSOverlay::FPSOverlay(SDL_FPoint const& center, ComponentPreset const& preset,
 
 void FPSOverlay::deinitialize() {
     Singleton<FPSOverlay>::deinitialize();
-    if (sFont != nullptr) {
-        TTF_CloseFont(sFont);
-        sFont = nullptr;
-    }
+    releaseGlyphAtlas();
 }
 
 
@@ -10,10 +10,7 @@ GameOverTitle::GameOverTitle(SDL_FPoint const& center, ComponentPreset const& pr
 
 void GameOverTitle::deinitialize() {
     Singleton<MenuTitle>::deinitialize();
-    if (sFont != nullptr) {
-        TTF_CloseFont(sFont);
-        sFont = nullptr;
-    }
+    releaseGlyphAtlas();
 }
 
 
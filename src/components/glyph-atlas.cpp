@@ -0,0 +1,147 @@
+#include <components.hpp>
+
+#include <algorithm>
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+
+#include <auxiliaries.hpp>
+
+
+/**
+ * @note Takes ownership of `font`.
+*/
+GlyphAtlas::GlyphAtlas(TTF_Font* font) : mFont(font) {}
+
+GlyphAtlas::~GlyphAtlas() {
+    if (mTexture != nullptr) {
+        SDL_DestroyTexture(mTexture);
+        mTexture = nullptr;
+    }
+
+    if (mFont != nullptr) {
+        TTF_CloseFont(mFont);
+        mFont = nullptr;
+    }
+}
+
+/**
+ * @brief Lay out `content`, a UTF-8 string, on a single line, applying kerning between consecutive glyphs.
+ * @param quads replaced with one quad per visible glyph.
+ * @return the size of the laid-out text.
+ * @note Glyphs not yet in the atlas are rasterized on the spot; those already in it cost a hash lookup each.
+*/
+SDL_Point GlyphAtlas::layout(std::string const& content, std::vector<Quad>& quads) {
+    quads.clear();
+    if (mFont == nullptr) return { 0, 0 };
+
+    SDL_Point size = { 0, TTF_FontHeight(mFont) };
+    int penX = 0;
+    Uint32 prevCodepoint = 0;
+
+    for (std::size_t i = 0; i < content.size();) {
+        auto codepoint = utils::nextCodepoint(content, i);
+        if (prevCodepoint) penX += TTF_GetFontKerningSizeGlyphs32(mFont, prevCodepoint, codepoint);
+        prevCodepoint = codepoint;
+
+        auto glyph = getGlyph(codepoint);
+        if (glyph == nullptr) continue;
+
+        if (glyph->srcRect.w && glyph->srcRect.h) {
+            quads.push_back({ glyph->srcRect, { penX + glyph->minX, 0, glyph->srcRect.w, glyph->srcRect.h } });
+            size.x = std::max(size.x, penX + glyph->minX + glyph->srcRect.w);
+            size.y = std::max(size.y, glyph->srcRect.h);
+        }
+
+        penX += glyph->advance;
+    }
+
+    size.x = std::max(size.x, penX);
+    return size;
+}
+
+/**
+ * @brief Retrieve the glyph of `codepoint`, rasterizing it into the atlas first if necessary.
+*/
+GlyphAtlas::Glyph const* GlyphAtlas::getGlyph(Uint32 codepoint) {
+    auto it = mGlyphs.find(codepoint);
+    if (it != mGlyphs.end()) return it->second.has_value() ? &it->second.value() : nullptr;
+
+    int minX, advance;
+    if (!TTF_GlyphIsProvided32(mFont, codepoint) || TTF_GlyphMetrics32(mFont, codepoint, &minX, nullptr, nullptr, nullptr, &advance)) {
+        mGlyphs.emplace(codepoint, std::nullopt);
+        return nullptr;
+    }
+
+    Glyph glyph = { { 0, 0, 0, 0 }, minX, advance };
+
+    // Rasterize once, in white, at the font's full line height so that glyphs share a baseline
+    SDL_Surface* surface = TTF_RenderGlyph32_Blended(mFont, codepoint, { 0xff, 0xff, 0xff, 0xff });
+    SDL_Surface* convertedSurface = surface != nullptr ? SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0) : nullptr;
+
+    SDL_Point origin;
+    if (convertedSurface != nullptr && convertedSurface->w && convertedSurface->h && pack({ convertedSurface->w, convertedSurface->h }, origin)) {
+        glyph.srcRect = { origin.x, origin.y, convertedSurface->w, convertedSurface->h };
+        SDL_UpdateTexture(mTexture, &glyph.srcRect, convertedSurface->pixels, convertedSurface->pitch);
+    }
+
+    if (convertedSurface != nullptr) SDL_FreeSurface(convertedSurface);
+    if (surface != nullptr) SDL_FreeSurface(surface);
+
+    return &mGlyphs.emplace(codepoint, glyph).first->second.value();
+}
+
+/**
+ * @brief Reserve a region of `size` in the atlas, in rows i.e. "shelves" as tall as their tallest glyph.
+*/
+bool GlyphAtlas::pack(SDL_Point const& size, SDL_Point& origin) {
+    while (true) {
+        if (mTexture != nullptr) {
+            if (mShelfOrigin.x + size.x > mTextureSize.x) {   // Start a new shelf
+                mShelfOrigin = { 0, mShelfOrigin.y + mShelfHeight + kPadding };
+                mShelfHeight = 0;
+            }
+
+            if (size.x <= mTextureSize.x && mShelfOrigin.y + size.y <= mTextureSize.y) {
+                origin = mShelfOrigin;
+                mShelfOrigin.x += size.x + kPadding;
+                mShelfHeight = std::max(mShelfHeight, size.y);
+                return true;
+            }
+        }
+
+        if (!grow(size)) return false;
+    }
+}
+
+/**
+ * @brief Replace the texture with one twice as tall (and as wide, if `minSize` requires), preserving its contents.
+*/
+bool GlyphAtlas::grow(SDL_Point const& minSize) {
+    SDL_Point nextSize = mTexture == nullptr ? config::components::glyph_atlas::initialSize : SDL_Point{ mTextureSize.x, mTextureSize.y << 1 };
+    while (nextSize.x < minSize.x) nextSize.x <<= 1;
+    while (nextSize.y < minSize.y) nextSize.y <<= 1;
+    if (nextSize.x > config::components::glyph_atlas::maxSize || nextSize.y > config::components::glyph_atlas::maxSize) return false;
+
+    auto texture = SDL_CreateTexture(globals::renderer, SDL_PixelFormatEnum::SDL_PIXELFORMAT_RGBA32, SDL_TextureAccess::SDL_TEXTUREACCESS_TARGET, nextSize.x, nextSize.y);
+    if (texture == nullptr) return false;
+
+    auto cachedRenderTarget = SDL_GetRenderTarget(globals::renderer);
+    SDL_SetRenderTarget(globals::renderer, texture);
+    SDL_SetRenderDrawColor(globals::renderer, 0, 0, 0, SDL_ALPHA_TRANSPARENT);
+    SDL_RenderClear(globals::renderer);
+
+    if (mTexture != nullptr) {
+        SDL_Rect destRect = { 0, 0, mTextureSize.x, mTextureSize.y };
+        SDL_SetTextureBlendMode(mTexture, SDL_BLENDMODE_NONE);   // Copy as is
+        SDL_RenderCopy(globals::renderer, mTexture, nullptr, &destRect);
+        SDL_DestroyTexture(mTexture);
+    }
+
+    SDL_SetRenderTarget(globals::renderer, cachedRenderTarget);
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    mTexture = texture;
+    mTextureSize = nextSize;
+    return true;
+}
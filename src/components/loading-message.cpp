@@ -10,10 +10,7 @@ LoadingMessage::LoadingMessage(SDL_FPoint const& center, ComponentPreset const&
 
 void LoadingMessage::deinitialize() {
     Singleton<LoadingMessage>::deinitialize();
-    if (sFont != nullptr) {
-        TTF_CloseFont(sFont);
-        sFont = nullptr;
-    }
+    releaseGlyphAtlas();
 }
 
 
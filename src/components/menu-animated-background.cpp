@@ -7,7 +7,7 @@
 
 
 MenuParallax::MenuParallax() {
-    mTexture = IMG_LoadTexture(globals::renderer, config::components::menu_parallax::path.generic_string().c_str());
+    mTexture = IMG_LoadTexture_RW(globals::renderer, globals::archive.open(config::components::menu_parallax::path), 1);
     SDL_QueryTexture(mTexture, nullptr, nullptr, &mSrcSize.x, &mSrcSize.y);
 
     mSrcRects.first.x = mSrcRects.first.y = mSrcRects.second.y = mDestRects.first.y = mDestRects.second.x = mDestRects.second.y = 0;
@@ -10,10 +10,7 @@ MenuTitle::MenuTitle(SDL_FPoint const& center, ComponentPreset const& preset, st
 
 void MenuTitle::deinitialize() {
     Singleton<MenuTitle>::deinitialize();
-    if (sFont != nullptr) {
-        TTF_CloseFont(sFont);
-        sFont = nullptr;
-    }
+    releaseGlyphAtlas();
 }
 
 
@@ -44,6 +44,8 @@ void GenericBoxComponent<T>::loadBoxTexture(SDL_Texture*& texture, ComponentPres
     mBoxDestRect.x = utils::ftoi(globals::windowSize.x * kCenter.x - mBoxDestRect.w / 2);
     mBoxDestRect.y = utils::ftoi(globals::windowSize.y * kCenter.y - mBoxDestRect.h / 2);
 
+    invalidate(mBoxDestRect);
+
     texture = SDL_CreateTexture(globals::renderer, SDL_PixelFormatEnum::SDL_PIXELFORMAT_RGBA32, 
     SDL_TextureAccess::SDL_TEXTUREACCESS_TARGET, mBoxDestRect.w, mBoxDestRect.h);
 
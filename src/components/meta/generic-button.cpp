@@ -39,19 +39,21 @@ void GenericButtonComponent<T>::deinitialize() {
 template <typename T>
 void GenericButtonComponent<T>::render() const {
     SDL_RenderCopy(globals::renderer, (mIsMouseOut ? mBoxTexture : mBoxTextureOnMouseOver), nullptr, &mBoxDestRect);
-    SDL_RenderCopy(globals::renderer, (mIsMouseOut ? mTextTexture : mTextTextureOnMouseOver), nullptr, &mTextDestRect);
+    renderText(mIsMouseOut ? kPreset.textColor : kOnMouseOverPreset.textColor);   // Same glyphs, tinted differently
 }
 
 template <typename T>
 void GenericButtonComponent<T>::onWindowChange() {
     GenericTextBoxComponent<T>::onWindowChange();
     loadBoxTexture(mBoxTextureOnMouseOver, kOnMouseOverPreset);
-    loadTextTexture(mTextTextureOnMouseOver, kOnMouseOverPreset);
 }
 
 template <typename T>
 void GenericButtonComponent<T>::handleMouseEvent(SDL_Event const& event) {
-    mIsMouseOut = !SDL_PointInRect(&globals::mouseState, &mBoxDestRect);
+    auto isMouseOut = !SDL_PointInRect(&globals::mouseState, &mBoxDestRect);
+    if (isMouseOut != mIsMouseOut) invalidate(mBoxDestRect);   // Hover state changed
+    mIsMouseOut = isMouseOut;
+
     if (!mIsMouseOut) sCurrAllMouseOutState = false;
     if (!mIsMouseOut && event.type == SDL_MOUSEBUTTONDOWN) onClick();
 }
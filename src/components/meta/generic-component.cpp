@@ -13,6 +13,15 @@ void GenericComponent<T>::onWindowChange() {
     sDestSize *= kDestSizeModifier;
 }
 
+/**
+ * @brief Mark `rect`, in window pixels, for recompositing by `UICompositor`.
+ * @note Should be called upon any change in how the component looks e.g. hover, content edit, window resize.
+*/
+template <typename T>
+void GenericComponent<T>::invalidate(SDL_Rect const& rect) const {
+    UICompositor::invoke(&UICompositor::invalidate, rect);
+}
+
 template <typename T>
 std::size_t std::hash<GenericComponent<T>>::operator()(GenericComponent<T> const*& instance) const {
     return instance == nullptr ? std::hash<std::nullptr_t>{}(instance) : std::hash<SDL_FPoint>(instance->kCenter);
@@ -7,72 +7,84 @@
 template <typename T>
 GenericTextComponent<T>::GenericTextComponent(SDL_FPoint const& center, ComponentPreset const& preset, std::string const& content) : GenericComponent<T>(center, preset), mContent(content) {}
 
-template <typename T>
-GenericTextComponent<T>::~GenericTextComponent() {
-    if (mTextTexture != nullptr) {
-        SDL_DestroyTexture(mTextTexture);
-        mTextTexture = nullptr;
-    }
-}
-
 template <typename T>
 void GenericTextComponent<T>::deinitialize() {
     Multiton<T>::deinitialize();
-    if (sFont != nullptr) {
-        TTF_CloseFont(sFont);
-        sFont = nullptr;
-    }
+    releaseGlyphAtlas();
 }
 
 template <typename T>
 void GenericTextComponent<T>::render() const {
-    SDL_RenderCopy(globals::renderer, mTextTexture, nullptr, &mTextDestRect);
+    renderText(kPreset.textColor);
 }
 
 template <typename T>
 void GenericTextComponent<T>::onWindowChange() {
-    static constexpr auto loadFont = [&]() {
-        if (sFont != nullptr) {
-            if (TTF_FontHeight(sFont) == sDestSize) return;
-            TTF_CloseFont(sFont);
-        }
+    GenericComponent<T>::onWindowChange();
 
-        sFont = TTF_OpenFont(sFontPath.generic_string().c_str(), sDestSize);   // Prevent `error: cannot convert 'const std::filesystem::__cxx11::path::value_type*' {aka 'const wchar_t*'} to 'const char*'`
-    };
+    // Acquire before releasing, so that an atlas shared between instances is not destroyed in between
+    auto glyphAtlas = FontService::instance != nullptr ? FontService::instance->acquire(sFontPath, sDestSize) : nullptr;
+    releaseGlyphAtlas();
+    sGlyphAtlas = glyphAtlas;
 
-    GenericComponent<T>::onWindowChange();
-    loadFont();
-    loadTextTexture(mTextTexture, kPreset);
+    layoutText();
 }
 
+/**
+ * @brief Lay out `mContent` as quads sampling from `sGlyphAtlas`, centered on `kCenter`.
+ * @note No texture is created; glyphs already in the atlas cost layout work only.
+*/
 template <typename T>
-void GenericTextComponent<T>::loadTextTexture(SDL_Texture*& texture, ComponentPreset const& preset) {
-    if (texture != nullptr) SDL_DestroyTexture(texture);
-
-    // Render text at high quality
-    SDL_Surface* surface = TTF_RenderUTF8_Blended(sFont, mContent.c_str(), preset.textColor);
-    if (surface == nullptr) return;
-
-    texture = SDL_CreateTextureFromSurface(globals::renderer, surface);
-    
-    // Register `innerSurface` dimensions to `innerDestRect`
-    mTextDestRect.w = surface->w;
-    mTextDestRect.h = surface->h;
+void GenericTextComponent<T>::layoutText() {
+    invalidate(mTextDestRect);   // Previous region, in case the text shrinks
+
+    if (sGlyphAtlas == nullptr) {
+        mTextQuads.clear();
+        return;
+    }
+
+    auto size = sGlyphAtlas->layout(mContent, mTextQuads);
+    mTextDestRect.w = size.x;
+    mTextDestRect.h = size.y;
     mTextDestRect.x = utils::ftoi(globals::windowSize.x * kCenter.x - mTextDestRect.w / 2);
     mTextDestRect.y = utils::ftoi(globals::windowSize.y * kCenter.y - mTextDestRect.h / 2);
 
-    SDL_FreeSurface(surface);
+    invalidate(mTextDestRect);
+}
+
+/**
+ * @brief Draw the laid-out glyphs tinted with `color`, in a single `SDL_RenderGeometry()` call.
+ * @note Flushes `globals::batcher`, since other components are drawn directly.
+*/
+template <typename T>
+void GenericTextComponent<T>::renderText(SDL_Color const& color) const {
+    if (sGlyphAtlas == nullptr || mTextQuads.empty()) return;
+
+    auto texture = sGlyphAtlas->getTexture();   // Might have been replaced since `layoutText()`
+    for (auto const& quad : mTextQuads) {
+        SDL_Rect destRect = { mTextDestRect.x + quad.destRect.x, mTextDestRect.y + quad.destRect.y, quad.destRect.w, quad.destRect.h };
+        globals::batcher.draw(texture, quad.srcRect, destRect, SDL_FLIP_NONE, 0, nullptr, color);
+    }
+
+    globals::batcher.flush(globals::renderer);
+}
+
+template <typename T>
+void GenericTextComponent<T>::releaseGlyphAtlas() {
+    FontService::invoke(&FontService::release, sGlyphAtlas);
+    sGlyphAtlas = nullptr;
 }
 
 template <typename T>
 void GenericTextComponent<T>::editContent(std::string const& nextContent) {
+    if (nextContent == mContent) return;
     mContent = nextContent;
-    loadTextTexture(mTextTexture, kPreset);
+    layoutText();
 }
 
 
 template <typename T>
-TTF_Font* GenericTextComponent<T>::sFont = nullptr;
+GlyphAtlas* GenericTextComponent<T>::sGlyphAtlas = nullptr;
 
 
 template class GenericTextComponent<FPSOverlay>;
@@ -81,4 +93,4 @@ template class GenericTextComponent<MenuButton>;
 template class GenericTextComponent<MenuTitle>;
 template class GenericTextComponent<LoadingMessage>;
 template class GenericTextComponent<GameOverTitle>;
-template class GenericTextComponent<GameOverButton>;
\ No newline at end of file
+template class GenericTextComponent<GameOverButton>;
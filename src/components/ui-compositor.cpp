@@ -0,0 +1,105 @@
+#include <components.hpp>
+
+#include <functional>
+
+#include <SDL.h>
+#include <auxiliaries.hpp>
+
+
+UICompositor::UICompositor(std::function<void(void)> const& callable) : kRenderMethod(callable) {}
+
+UICompositor::~UICompositor() {
+    if (mTexture != nullptr) {
+        SDL_DestroyTexture(mTexture);
+        mTexture = nullptr;
+    }
+}
+
+/**
+ * @brief Recomposite dirty regions if any, then copy the retained UI to the current render target.
+*/
+void UICompositor::render() {
+    if (globals::state != mPrevState) {
+        mPrevState = globals::state;
+        invalidateAll();   // A different set of components is shown
+    }
+
+    mStats = Stats{};
+    if (!mDirtyRects.empty()) recomposite();
+
+    SDL_RenderCopy(globals::renderer, mTexture, nullptr, nullptr);
+}
+
+/**
+ * @brief Recreate the retained texture at window size.
+ * @note Components are expected to invalidate their own regions upon reloading their textures; the whole window is invalidated regardless, since the previous contents are lost.
+*/
+void UICompositor::onWindowChange() {
+    if (mTexture != nullptr) SDL_DestroyTexture(mTexture);
+    mTextureSize = globals::windowSize;
+    mTexture = SDL_CreateTexture(globals::renderer, SDL_PixelFormatEnum::SDL_PIXELFORMAT_RGBA32, SDL_TextureAccess::SDL_TEXTUREACCESS_TARGET, mTextureSize.x, mTextureSize.y);
+
+    // Blending into a transparent target yields premultiplied colors, which must not be multiplied by alpha again
+    auto premultipliedBlendMode = SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD, SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    if (SDL_SetTextureBlendMode(mTexture, premultipliedBlendMode)) SDL_SetTextureBlendMode(mTexture, SDL_BLENDMODE_BLEND);   // Unsupported by some renderers, at the cost of slightly darkened edges
+
+    invalidateAll();
+}
+
+/**
+ * @brief Mark `rect`, in window pixels, for recompositing on the next `render()`.
+ * @note Overlapping dirty rects are merged, so that no pixel is recomposited twice.
+*/
+void UICompositor::invalidate(SDL_Rect const& rect) {
+    SDL_Rect windowRect = { 0, 0, mTextureSize.x, mTextureSize.y }, dirtyRect;
+    if (!SDL_IntersectRect(&rect, &windowRect, &dirtyRect)) return;
+
+    for (auto it = mDirtyRects.begin(); it != mDirtyRects.end();) {
+        if (!SDL_HasIntersection(&*it, &dirtyRect)) { ++it; continue; }
+        SDL_UnionRect(&*it, &dirtyRect, &dirtyRect);
+        mDirtyRects.erase(it);
+        it = mDirtyRects.begin();   // The merged rect might now overlap previously disjoint ones
+    }
+
+    mDirtyRects.push_back(dirtyRect);
+    if (mDirtyRects.size() <= config::components::ui_compositor::maxDirtyRectCount) return;
+
+    for (auto const& otherDirtyRect : mDirtyRects) SDL_UnionRect(&otherDirtyRect, &dirtyRect, &dirtyRect);
+    mDirtyRects = { dirtyRect };
+}
+
+void UICompositor::invalidateAll() {
+    mDirtyRects = { { 0, 0, mTextureSize.x, mTextureSize.y } };
+}
+
+/**
+ * @brief Clear then re-render every component within each dirty rect, clipped to it.
+*/
+void UICompositor::recomposite() {
+    if (mTexture == nullptr) return;
+
+    auto cachedRenderTarget = SDL_GetRenderTarget(globals::renderer);
+    SDL_BlendMode cachedBlendMode;
+    SDL_GetRenderDrawBlendMode(globals::renderer, &cachedBlendMode);
+
+    SDL_SetRenderTarget(globals::renderer, mTexture);
+
+    for (auto const& rect : mDirtyRects) {
+        SDL_RenderSetClipRect(globals::renderer, &rect);
+
+        // `SDL_RenderClear()` ignores the clip rect
+        SDL_SetRenderDrawBlendMode(globals::renderer, SDL_BLENDMODE_NONE);
+        SDL_SetRenderDrawColor(globals::renderer, 0, 0, 0, SDL_ALPHA_TRANSPARENT);
+        SDL_RenderFillRect(globals::renderer, &rect);
+        SDL_SetRenderDrawBlendMode(globals::renderer, cachedBlendMode);
+
+        std::invoke(kRenderMethod);
+
+        mStats.recompositedPixels += static_cast<std::size_t>(rect.w) * rect.h;
+        ++mStats.recompositedRects;
+    }
+
+    SDL_RenderSetClipRect(globals::renderer, nullptr);
+    SDL_SetRenderTarget(globals::renderer, cachedRenderTarget);
+    mDirtyRects.clear();
+}
@@ -56,6 +56,7 @@ bool AbstractAnimatedDynamicEntity<T>::isWithinRange(std::pair<int, int> const&
 template <typename T>
 void AbstractAnimatedDynamicEntity<T>::move() {
     if (mNextDestCoords == nullptr || !mMoveDelayTimer.isFinished()) return;   // Return if the move has not been "initiated"
+    auto prevDestRect = mDestRect;
 
     mDestRect.x += mCurrVelocity.x * mIntegralVelocity.x;
     mDestRect.y += mCurrVelocity.y * mIntegralVelocity.y;
@@ -74,6 +75,8 @@ void AbstractAnimatedDynamicEntity<T>::move() {
         --mFractionalVelocityCounter.y;
     }
 
+    AbstractEntity<T>::relocateWithinSpatialGrid(prevDestRect);
+
     // Continue movement if new `Tile` has not been reached
     if ((mNextDestRect->x - mDestRect.x) * mCurrVelocity.x > 0 || (mNextDestRect->y - mDestRect.y) * mCurrVelocity.y > 0) return;   // Not sure this is logically acceptable but this took 3 hours of debugging so just gonna keep it anyway
 
@@ -151,8 +154,10 @@ void AbstractAnimatedDynamicEntity<T>::onMoveEnd(BehaviouralType flag) {
     // Terminate movement when reached new `Tile`
     if (mNextDestCoords != nullptr && mNextDestRect != nullptr) {
         if (flag != BehaviouralType::kInvalidated && flag != BehaviouralType::kAutopilot) {
+            auto prevDestRect = mDestRect;
             mDestCoords = *mNextDestCoords;
             mDestRect = *mNextDestRect;
+            AbstractEntity<T>::relocateWithinSpatialGrid(prevDestRect);
         }
 
         delete mNextDestCoords;
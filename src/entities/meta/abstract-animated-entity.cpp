@@ -15,6 +15,11 @@ AbstractAnimatedEntity<T>::AbstractAnimatedEntity(SDL_Point const& destCoords) :
     if (!sTilesetPath.empty()) resetAnimation(Animation::kIdle);
 }
 
+template <typename T>
+AbstractAnimatedEntity<T>::~AbstractAnimatedEntity() {
+    if (mAnimationTimerHandle != TimerWheel::kInvalidHandle) TimerWheel::invoke(&TimerWheel::cancel, mAnimationTimerHandle);
+}
+
 template <typename T>
 void AbstractAnimatedEntity<T>::reinitialize(std::filesystem::path path) {
     AbstractEntity<T>::reinitialize(path);
@@ -33,55 +38,44 @@ void AbstractAnimatedEntity<T>::onLevelChange(level::Data_Generic const& entityL
 }
 
 /**
+ * @brief Emit the SFX of the current animation once, upon reaching its first sprite.
  * @note `AnimationType::kWalk` & `AnimationType:kRun` are handled elsewhere.
+ * @note Throttling across entities is left to `Mixer`, which rate-limits each effect and bounds the number of voices.
  * @see https://stackoverflow.com/questions/41011900/equivalent-ternary-operator-for-constexpr-if
 */
 template <typename T>
 void AbstractAnimatedEntity<T>::handleSFX() const {
-    static CountdownTimer timer(config::entities::SFXTicks);
-    if (!timer.isStarted()) timer.start();
-    if (!timer.isFinished()) return;
+    bool wasAnimationAtFirstSprite = mWasAnimationAtFirstSprite;
+    mWasAnimationAtFirstSprite = isAnimationAtFirstSprite();
+    if (!mWasAnimationAtFirstSprite || wasAnimationAtFirstSprite) return;
 
     switch (mAnimation) {
         case Animation::kAttackMeele:
-            if (!isAnimationAtFirstSprite()) break;
-            Mixer::invoke(&Mixer::playSFX, std::is_same_v<T, Player> ? Mixer::SFXName::kPlayerAttack : Mixer::SFXName::kEntityAttack);
+            Mixer::invoke(&Mixer::playSFXAt, std::is_same_v<T, Player> ? Mixer::SFXName::kPlayerAttack : Mixer::SFXName::kEntityAttack, mDestCoords);
             break;
 
         case Animation::kDamaged:
-            if (!isAnimationAtFirstSprite()) break;
-            Mixer::invoke(&Mixer::playSFX, Mixer::SFXName::kEntityDamaged);
+            Mixer::invoke(&Mixer::playSFXAt, Mixer::SFXName::kEntityDamaged, mDestCoords);
             break;
 
         case Animation::kDeath:
-            if (!isAnimationAtFirstSprite()) break;
-            Mixer::invoke(&Mixer::playSFX, std::is_same_v<T, Player> ? Mixer::SFXName::kPlayerDeath : Mixer::SFXName::kEntityDeath);
+            Mixer::invoke(&Mixer::playSFXAt, std::is_same_v<T, Player> ? Mixer::SFXName::kPlayerDeath : Mixer::SFXName::kEntityDeath, mDestCoords);
             break;
 
         default: break;
     }
-
-    timer.start();
 }
 
 /**
  * @brief Switch from one sprite to the next. Called every `animationTicks` frames.
+ * @note Sprite switching itself is driven by `TimerWheel`, see `onAnimationTimerFinished()`.
  * @see <interface.h> Interface::renderLevelTiles()
 */
 template <typename T>
 void AbstractAnimatedEntity<T>::updateAnimation() {
-    if (!mAnimationTimer.isStarted()) mAnimationTimer.start();
-    if (mAnimationTimer.isFinished()) {
-        mAnimationTimer.stop();
-
-        if (mAnimationGID < mAnimationData.stopGID) {
-            mAnimationGID += sTilesetData.animationSize.x;
-            if (mAnimationGID / sTilesetData.srcCount.x != (mAnimationGID - sTilesetData.animationSize.x) / sTilesetData.srcCount.x) mAnimationGID += sTilesetData.srcCount.x * (sTilesetData.animationSize.y - 1);   // Originally intended for "flawed" tilesets where `sTilesetData.animationSize.x` > 'sTilesetData.srcCount.x`
-        } else {
-            if (mAnimation == Animation::kDeath) return;   // The real permanent
-            if (tile::Data_EntityTileset::getContinuity(mAnimation)) resetAnimation(mAnimation);
-            else resetAnimation(mBaseAnimation, BehaviouralType::kPrioritized);
-        }
+    if (mAnimationTimerHandle == TimerWheel::kInvalidHandle && mAnimationTimerExpiryTick != FrameClock::getTickCount()) {   // Restart on the tick after expiry, preserving the cadence of the former per-tick polling
+        mAnimationTimer.start();
+        if (mAnimationTimer.isFinished()) onAnimationTimerFinished(); else scheduleAnimationTimer();
     }
 
     if (sTilesetData.srcCount.x) {
@@ -90,6 +84,37 @@ void AbstractAnimatedEntity<T>::updateAnimation() {
     }
 }
 
+/**
+ * @brief Register the expiry of `mAnimationTimer`, accounting for the time already elapsed.
+*/
+template <typename T>
+void AbstractAnimatedEntity<T>::scheduleAnimationTimer() {
+    if (TimerWheel::instance == nullptr) return;
+
+    auto ticks = mAnimationTimer.getTicks();
+    auto maxTicks = mAnimationTimer.getMaxTicks();
+    mAnimationTimerHandle = TimerWheel::instance->schedule(ticks < maxTicks ? maxTicks - ticks : 0, [this]() { onAnimationTimerFinished(); });
+}
+
+/**
+ * @brief Advance to the next sprite once `mAnimationTimer` expires.
+ * @note The timer is restarted by the next `updateAnimation()` i.e. an entity that is no longer updated e.g. culled, leaves no pending timer behind.
+*/
+template <typename T>
+void AbstractAnimatedEntity<T>::onAnimationTimerFinished() {
+    mAnimationTimer.stop();
+    mAnimationTimerHandle = TimerWheel::kInvalidHandle;
+    mAnimationTimerExpiryTick = FrameClock::getTickCount();
+
+    if (mAnimationGID < mAnimationData.stopGID) {
+        mAnimationGID += sTilesetData.animationSize.x;
+        if (mAnimationGID / sTilesetData.srcCount.x != (mAnimationGID - sTilesetData.animationSize.x) / sTilesetData.srcCount.x) mAnimationGID += sTilesetData.srcCount.x * (sTilesetData.animationSize.y - 1);   // Originally intended for "flawed" tilesets where `sTilesetData.animationSize.x` > 'sTilesetData.srcCount.x`
+    } else if (mAnimation != Animation::kDeath) {   // The real permanent
+        if (tile::Data_EntityTileset::getContinuity(mAnimation)) resetAnimation(mAnimation);
+        else resetAnimation(mBaseAnimation, BehaviouralType::kPrioritized);
+    }
+}
+
 /**
  * @brief Switch to new animation type i.e. new collection of sprites.
 */
@@ -101,6 +126,10 @@ void AbstractAnimatedEntity<T>::resetAnimation(Animation animation, BehaviouralT
     mAnimationData = sTilesetData.at(mAnimation, sTilesetData.isMultiDirectional ? mDirection : tile::Data_EntityTileset::kDefaultDirection);
 
     mAnimationTimer.setMaxTicks(sTilesetData.animationTicks * mAnimationData.ticksMultiplier);
+    if (mAnimationTimer.isStarted() && mAnimationTimerHandle != TimerWheel::kInvalidHandle) {   // Expiry pending, re-register against the new duration
+        TimerWheel::invoke(&TimerWheel::cancel, mAnimationTimerHandle);
+        scheduleAnimationTimer();
+    }
 
     if (flag != BehaviouralType::kContinued && flag != BehaviouralType::kAutopilot) mAnimationGID = mAnimationData.startGID;
 }
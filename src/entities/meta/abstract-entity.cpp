@@ -3,13 +3,17 @@
 #include <algorithm>
 #include <filesystem>
 #include <functional>
+#include <memory>
 #include <unordered_set>
+#include <utility>
 #include <type_traits>
 
 #include <SDL.h>
 #include <SDL_image.h>
 #include <pugixml/pugixml.hpp>
 
+#include <loader.hpp>
+
 #include <meta.hpp>
 #include <auxiliaries.hpp>
 
@@ -18,6 +22,7 @@ template <typename T>
 AbstractEntity<T>::AbstractEntity(SDL_Point const& destCoords) : mID(++sID_Counter), mDestCoords(destCoords), mDestRectModifier(config::entities::destRectModifier) {
     mSrcRect.w = sTilesetData.srcSize.x * sTilesetData.animationSize.x;
     mSrcRect.h = sTilesetData.srcSize.y * sTilesetData.animationSize.y;
+    invalidateSpatialGrid();
 }
 
 /**
@@ -26,11 +31,53 @@ AbstractEntity<T>::AbstractEntity(SDL_Point const& destCoords) : mID(++sID_Count
 template <typename T>
 void AbstractEntity<T>::initialize() {
     pugi::xml_document document;
-    pugi::xml_parse_result result = document.load_file(sTilesetPath.c_str()); if (!result) return;   // Should be replaced with `result.status` or `pugi::xml_parse_status`
+    pugi::xml_parse_result result = utils::fetch(sTilesetPath, document); if (!result) return;   // Should be replaced with `result.status` or `pugi::xml_parse_status`
     
     sTilesetData.load(document, globals::renderer);
 }
 
+/**
+ * @brief Equivalent to `initialize()`, except that the tileset is parsed and decoded on `AssetLoader` workers. Only the texture is created on the main thread, once finalized.
+ * @note `sTilesetData` is unusable until `awaitInitialize()` returns, or `AssetLoader` has finalized the task on its own.
+*/
+template <typename T>
+void AbstractEntity<T>::initializeAsync() {
+    if (AssetLoader::instance == nullptr) {
+        initialize();
+        return;
+    }
+
+    struct Decoded {
+        ~Decoded() { if (surface != nullptr) SDL_FreeSurface(surface); }
+
+        pugi::xml_document document;
+        bool isParsed = false;
+        SDL_Surface* surface = nullptr;
+    };
+
+    auto decoded = std::make_shared<Decoded>();
+    auto path = sTilesetPath;
+
+    sInitializeTask = AssetLoader::instance->submit({
+        [decoded, path]() {
+            decoded->isParsed = utils::fetch(path, decoded->document);
+            if (decoded->isParsed) decoded->surface = tile::Data_Generic::decode(decoded->document);
+        },
+        [decoded]() {
+            if (!decoded->isParsed) return;
+            sTilesetData.load(decoded->document, std::exchange(decoded->surface, nullptr), globals::renderer);
+        },
+    });
+}
+
+/**
+ * @brief Block until the tileset submitted by `initializeAsync()` is usable e.g. prior to instantiation.
+*/
+template <typename T>
+void AbstractEntity<T>::awaitInitialize() {
+    if (sInitializeTask.has_value()) AssetLoader::invoke(&AssetLoader::wait, sInitializeTask.value());
+}
+
 template <typename T>
 void AbstractEntity<T>::deinitialize() {
     sTilesetData.clear();
@@ -52,11 +99,25 @@ void AbstractEntity<T>::reinitialize(std::filesystem::path path) {
 
 /**
  * @brief Render the current sprite to the window.
+ * @note The sprite is queued to `globals::batcher`, and only reaches the render target once the batcher is flushed.
  * @note Recommended implementation: this method requires `destRect` and `srcRect` to be set properly prior to being called.
 */
 template <typename T>
 void AbstractEntity<T>::render() const {
-    SDL_RenderCopyEx(globals::renderer, sTilesetData.texture, &mSrcRect, &mDestRect, mAngle, mCenter, mFlip);
+    globals::batcher.draw(sTilesetData.texture, mSrcRect, mInterpolatedDestRect, mFlip, mAngle, mCenter);
+}
+
+/**
+ * @brief Blend the positions before and after the latest simulation tick.
+ * @param alpha the fraction of a tick elapsed since the latest simulation tick, in `[0, 1)`.
+*/
+template <typename T>
+void AbstractEntity<T>::interpolateDestRect(double alpha) {
+    mInterpolatedDestRect = mDestRect;
+    if (!mPrevDestRect.has_value()) return;
+
+    mInterpolatedDestRect.x = mPrevDestRect->x + utils::ftoi((mDestRect.x - mPrevDestRect->x) * alpha);
+    mInterpolatedDestRect.y = mPrevDestRect->y + utils::ftoi((mDestRect.y - mPrevDestRect->y) * alpha);
 }
 
 /**
@@ -64,7 +125,9 @@ void AbstractEntity<T>::render() const {
 */
 template <typename T>
 void AbstractEntity<T>::onWindowChange() {
-    mDestRect = getDestRectFromCoords(mDestCoords);
+    mDestRect = mInterpolatedDestRect = getDestRectFromCoords(mDestCoords);
+    mPrevDestRect.reset();   // Snap instead of sliding across the discontinuity
+    invalidateSpatialGrid();
 }
 
 /**
@@ -89,6 +152,7 @@ AbstractEntity<T>::syncPlayerMovement() {
     if constexpr(std::is_same_v<T, Player>) return;
 
     if (Player::instance == nullptr) return;
+    invalidateSpatialGrid();
     auto dDestCoords = Player::instance->getDestCoordsDifference();
     auto dDestRect = Player::instance->getDestRectDifference();
 
@@ -103,6 +167,20 @@ AbstractEntity<T>::syncPlayerMovement() {
     }
 }
 
+/**
+ * @brief Re-bucket every instance by its current `mDestRect`.
+ * @note Only required when instances are added, removed, or moved all at once e.g. by `syncPlayerMovement()`. Individual moves are handled by `relocateWithinSpatialGrid()`.
+*/
+template <typename T>
+void AbstractEntity<T>::updateSpatialGrid() {
+    sSpatialGrid.reset(
+        { level::data.tileDestCount.x * level::data.tileDestSize.x, level::data.tileDestCount.y * level::data.tileDestSize.y },
+        { config::entities::CullingBucketSize * level::data.tileDestSize.x, config::entities::CullingBucketSize * level::data.tileDestSize.y }
+    );
+    for (auto& instance : instances) if (instance != nullptr) sSpatialGrid.insert(instance, instance->mDestRect);
+    sIsSpatialGridOutdated = false;
+}
+
 /**
  * Adjust `destRect` based on `tilesetData->animationSize` and `destRectModifier`.
  * @return A `SDL_Rect` representing the position of the instance of derived class `T`, relative to the window.
@@ -154,6 +232,15 @@ tile::Data_EntityTileset AbstractEntity<T>::sTilesetData;
 template <typename T>
 int AbstractEntity<T>::sID_Counter = 0;
 
+template <typename T>
+std::optional<AssetLoader::TaskID> AbstractEntity<T>::sInitializeTask;
+
+template <typename T>
+SpatialGrid<T> AbstractEntity<T>::sSpatialGrid;
+
+template <typename T>
+bool AbstractEntity<T>::sIsSpatialGridOutdated = true;
+
 
 /**
  * @note Explicit Template Instantiation.
@@ -1,6 +1,9 @@
 #include <entities.hpp>
 
+#include <algorithm>
 #include <chrono>
+#include <cstdlib>
+#include <memory>
 
 #include <SDL.h>
 
@@ -12,10 +15,9 @@ template <typename T, MovementSelectionType M>
 GenericHostileEntity<T, M>::GenericHostileEntity(SDL_Point const& destCoords) : AbstractAnimatedDynamicEntity<T>(destCoords) {}
 
 template <typename T, MovementSelectionType M>
-void GenericHostileEntity<T, M>::handleCustomEventPOST() const {
-    handleCustomEventPOST_impl<event::Code::kReq_AttackRegister_GHE_Player>();
-    handleCustomEventPOST_impl<event::Code::kReq_AttackInitiate_GHE_Player>();
-    handleCustomEventPOST_impl<event::Code::kReq_MoveInitiate_GHE_Player>();
+GenericHostileEntity<T, M>::~GenericHostileEntity() {
+    --sDeathCount;
+    if (mTicket != pathfinders::PathService::kInvalidTicket) pathfinders::service.cancel(mTicket);
 }
 
 template <typename T, MovementSelectionType M>
@@ -25,65 +27,34 @@ void GenericHostileEntity<T, M>::handleCustomEventGET(SDL_Event const& event) {
             handleCustomEventGET_impl<event::Code::kReq_AttackRegister_Player_GHE>(event);
             break;
 
-        case event::Code::kResp_AttackInitiate_GHE_Player:
-            if (event::getID(event) != mID) return;
-            handleCustomEventGET_impl<event::Code::kResp_AttackInitiate_GHE_Player>();
-            break;
-
-        case event::Code::kResp_MoveInitiate_GHE_Player:
-            if (event::getID(event) != mID) return;
-            handleCustomEventGET_impl<event::Code::kResp_MoveInitiate_GHE_Player>(event);
-            break;
-
-        case event::Code::kResp_MoveTerminate_GHE_Player:
-            if (event::getID(event) != mID) return;
-            handleCustomEventGET_impl<event::Code::kResp_MoveTerminate_GHE_Player>();
-            break;
-
         default: break;
     }
 }
 
+/**
+ * @brief Evaluate range checks and movement selection against `snapshot`, then write the resulting intents straight onto the entity.
+ * @note Called once per tick for every instance, before `move()`.
+*/
 template <typename T, MovementSelectionType M>
-void GenericHostileEntity<T, M>::instantiateMeteorProjectileOnSelf() {
-    Meteor::initiateAttack(ProjectileType::kOrthogonalSingle, mDestCoords, { 0, 0 });
-}
+void GenericHostileEntity<T, M>::handleDecision(PlayerSnapshot const& snapshot) {
+    if (mAnimation == Animation::kAttackMeele) {
+        if (isAnimationAtFinalSprite()) Player::invoke(&Player::onAttackRegistered, mAttributes, mDestCoords);
+    } else if (snapshot.animation != Animation::kDamaged && snapshot.animation != Animation::kDeath && mAttributes.template within<EntityAttributes::ID::AIR>(snapshot.destCoords, mDestCoords)) resetAnimation(Animation::kAttackMeele);
 
-template <typename T, MovementSelectionType M>
-template <event::Code C>
-typename std::enable_if_t<C == event::Code::kReq_AttackRegister_GHE_Player>
-GenericHostileEntity<T, M>::handleCustomEventPOST_impl() const {
-    if (mAnimation != Animation::kAttackMeele || !isAnimationAtFinalSprite()) return;
-
-    auto event = event::instantiate();
-    event::setID(event, mID);
-    event::setCode(event, C);
-    event::setData(event, event::Data_Generic({ mDestCoords, &mAttributes }));
-    event::enqueue(event);
-}
+    if (snapshot.animation == Animation::kDeath) return;
 
-template <typename T, MovementSelectionType M>
-template <event::Code C>
-typename std::enable_if_t<C == event::Code::kReq_AttackInitiate_GHE_Player>
-GenericHostileEntity<T, M>::handleCustomEventPOST_impl() const {
-    if (mAnimation == Animation::kAttackMeele) return;
-
-    auto event = event::instantiate();
-    event::setID(event, mID);
-    event::setCode(event, C);
-    event::setData(event, event::Data_Generic({ mDestCoords, &mAttributes }));
-    event::enqueue(event);
+    if (mAttributes.template within<EntityAttributes::ID::MIR>(snapshot.destCoords, mDestCoords)) {
+        calculateNextMovement(snapshot.destCoords);
+        initiateMove();
+    } else {
+        delete mNextVelocity;
+        mNextVelocity = nullptr;
+    }
 }
 
 template <typename T, MovementSelectionType M>
-template <event::Code C>
-typename std::enable_if_t<C == event::Code::kReq_MoveInitiate_GHE_Player>
-GenericHostileEntity<T, M>::handleCustomEventPOST_impl() const {
-    auto event = event::instantiate();
-    event::setID(event, mID);
-    event::setCode(event, C);
-    event::setData(event, event::Data_Generic({ mDestCoords, &mAttributes }));
-    event::enqueue(event);
+void GenericHostileEntity<T, M>::instantiateMeteorProjectileOnSelf() {
+    Meteor::initiateAttack(ProjectileType::kOrthogonalSingle, mDestCoords, { 0, 0 });
 }
 
 template <typename T, MovementSelectionType M>
@@ -104,30 +75,6 @@ GenericHostileEntity<T, M>::handleCustomEventGET_impl(SDL_Event const& event) {
     }
 }
 
-template <typename T, MovementSelectionType M>
-template <event::Code C>
-typename std::enable_if_t<C == event::Code::kResp_AttackInitiate_GHE_Player>
-GenericHostileEntity<T, M>::handleCustomEventGET_impl() {
-    resetAnimation(Animation::kAttackMeele);
-}
-
-template <typename T, MovementSelectionType M>
-template <event::Code C>
-typename std::enable_if_t<C == event::Code::kResp_MoveInitiate_GHE_Player>
-GenericHostileEntity<T, M>::handleCustomEventGET_impl(SDL_Event const& event) {
-    auto data = event::getData<event::Data_Generic>(event);
-    calculateNextMovement(data.destCoords);
-    initiateMove();
-}
-
-template <typename T, MovementSelectionType M>
-template <event::Code C>
-typename std::enable_if_t<C == event::Code::kResp_MoveTerminate_GHE_Player>
-GenericHostileEntity<T, M>::handleCustomEventGET_impl() {
-    delete mNextVelocity;
-    mNextVelocity = nullptr;
-}
-
 template <typename T, MovementSelectionType M>
 template <MovementSelectionType M_>
 typename std::enable_if_t<M_ == MovementSelectionType::kGreedyTrigonometric>
@@ -141,6 +88,7 @@ GenericHostileEntity<T, M>::calculateNextMovement(SDL_Point const& targetDestCoo
         return tile::Data_EntityTileset::kDefaultDirection;
     };
 
+    delete mNextVelocity;
     mNextVelocity = new SDL_Point(dir(targetDestCoords, mDestCoords));
 }
 
@@ -148,34 +96,98 @@ template <typename T, MovementSelectionType M>
 template <MovementSelectionType M_>
 typename std::enable_if_t<M_ == MovementSelectionType::kGreedyRandomBinary>
 GenericHostileEntity<T, M>::calculateNextMovement(SDL_Point const& targetDestCoords) {
+    delete mNextVelocity;
     mNextVelocity = utils::generateRandomBinary() ? new SDL_Point({ (targetDestCoords.x > mDestCoords.x) * 2 - 1, 0 }) : new SDL_Point({ 0, (targetDestCoords.y > mDestCoords.y) * 2 - 1 });
 }
 
 /**
- * @warning Bugged, do not use this.
+ * @brief Follow a path from the per-instance incremental planner towards `targetDestCoords`.
+ * @note Replans at most every `config::entities::ASPFTicks`, following the previous path in between. Only the part of the previous search invalidated by the movement of either endpoint is recomputed.
+ * @note Searches are confined to twice the MIR around an anchor, which is moved, discarding the search state, only once the instance strays further than the MIR from it. Since decisions are taken within the MIR of the target, the target always lies within the window.
 */
 template <typename T, MovementSelectionType M>
 template <MovementSelectionType M_>
 typename std::enable_if_t<M_ == MovementSelectionType::kPathfindingAStar>
 GenericHostileEntity<T, M>::calculateNextMovement(SDL_Point const& targetDestCoords) {
-    static auto pathfinder = pathfinders::ASPF<pathfinders::Heuristic::kManhattan, pathfinders::MovementType::k4Directional>(level::data.collisionTilelayer);
+    auto cell = pathfinders::Cell::pttocl(mDestCoords);
+
+    // Resume from the current position, which might have advanced since the last replan
+    auto it = std::find(mPath.begin(), mPath.end(), cell);
+    if (it != mPath.end()) mPath.erase(it, mPath.end());
+    else mPath.clear();
+
+    if (!mReplanTimer.isStarted() || mReplanTimer.isFinished()) {
+        auto MIR = mAttributes.template get<EntityAttributes::ID::MIR>();
+
+        if (mPlanner == nullptr) {
+            mPlanner = std::make_unique<pathfinders::DSLPF>(level::data.collisionTilelayer, &pathfinders::components);
+            mPlannerAnchor = { cell.x + 2 * MIR.x + 1, cell.y };   // Forces anchoring below
+        }
+        if (std::abs(cell.x - mPlannerAnchor.x) > MIR.x || std::abs(cell.y - mPlannerAnchor.y) > MIR.y) {
+            mPlannerAnchor = cell;
+            mPlanner->setBegin({ cell.x - 2 * MIR.x, cell.y - 2 * MIR.y });
+            mPlanner->setEnd({ cell.x + 2 * MIR.x, cell.y + 2 * MIR.y });
+        }
+
+        if (mPlanner->search(cell, pathfinders::Cell::pttocl(targetDestCoords), mPath) == pathfinders::Status::kSuccess) mPath.pop_back();   // The source i.e. current position
+        mReplanTimer.start();
+    }
+
+    if (mPath.empty()) return;
+
+    delete mNextVelocity;
+    mNextVelocity = new SDL_Point( pathfinders::Cell::cltopt(mPath.back()) - mDestCoords );
+}
+
+/**
+ * @brief Follow the shared distance field rooted at `targetDestCoords`.
+ * @note All instances chasing the same target share one field, which is repaired rather than rebuilt whenever the target moves by one tile.
+*/
+template <typename T, MovementSelectionType M>
+template <MovementSelectionType M_>
+typename std::enable_if_t<M_ == MovementSelectionType::kPathfindingDijkstra>
+GenericHostileEntity<T, M>::calculateNextMovement(SDL_Point const& targetDestCoords) {
+    auto nextCell = pathfinders::flowfields.get(pathfinders::Cell::pttocl(targetDestCoords)).getNextCell(pathfinders::Cell::pttocl(mDestCoords));
+    if (!nextCell.has_value()) return;
 
-    static auto timer = CountdownTimer(config::entities::ASPFTicks);
-    if (!timer.isStarted()) timer.start();
-    if (!timer.isFinished()) return;
+    delete mNextVelocity;
+    mNextVelocity = new SDL_Point(pathfinders::Cell::cltopt(nextCell.value()) - mDestCoords);
+}
 
-    pathfinder.setBegin(pathfinders::Cell::pttocl(mDestCoords - mAttributes.template get<EntityAttributes::ID::MIR>()));
-    pathfinder.setEnd(pathfinders::Cell::pttocl(mDestCoords + mAttributes.template get<EntityAttributes::ID::MIR>()));
+/**
+ * @brief Follow a path searched off the main thread, see `pathfinders::PathService`.
+ * @note The previous path is followed until the requested one is published. A request is superseded, and cancelled, as soon as `targetDestCoords` moves.
+*/
+template <typename T, MovementSelectionType M>
+template <MovementSelectionType M_>
+typename std::enable_if_t<M_ == MovementSelectionType::kPathfindingAsync>
+GenericHostileEntity<T, M>::calculateNextMovement(SDL_Point const& targetDestCoords) {
+    if (mTicket != pathfinders::PathService::kInvalidTicket) {
+        auto result = pathfinders::service.retrieve(mTicket);
+        if (result.has_value()) {
+            mTicket = pathfinders::PathService::kInvalidTicket;
+            if (result->status == pathfinders::Status::kSuccess) mPath = std::move(result->path);
+        }
+    }
 
-    auto result = pathfinder.search(pathfinders::Cell::pttocl(mDestCoords), pathfinders::Cell::pttocl(targetDestCoords));
-    if (result.status != pathfinders::Status::kSuccess || result.path.empty()) return;
+    // Resume from the current position, which might have advanced since the path was requested
+    auto it = std::find(mPath.begin(), mPath.end(), pathfinders::Cell::pttocl(mDestCoords));
+    if (it != mPath.end()) mPath.erase(it, mPath.end());
+    else if (!mPath.empty()) {
+        mPath.clear();
+        mRequestedDestCoords = { -1, -1 };   // Knocked off the path
+    }
 
-    result.path.pop();
-    if (result.path.empty()) return;
+    if (targetDestCoords != mRequestedDestCoords) {
+        if (mTicket != pathfinders::PathService::kInvalidTicket) pathfinders::service.cancel(mTicket);
+        mTicket = pathfinders::service.submit({ pathfinders::Cell::pttocl(mDestCoords), pathfinders::Cell::pttocl(targetDestCoords) });
+        mRequestedDestCoords = targetDestCoords;
+    }
 
-    mNextVelocity = new SDL_Point( pathfinders::Cell::cltopt(result.path.top()) - mDestCoords );
+    if (mPath.empty()) return;
 
-    timer.start();
+    delete mNextVelocity;
+    mNextVelocity = new SDL_Point(pathfinders::Cell::cltopt(mPath.back()) - mDestCoords);
 }
 
 
@@ -183,23 +195,23 @@ template <typename T, MovementSelectionType M>
 unsigned int GenericHostileEntity<T, M>::sDeathCount = 0;
 
 
-template class GenericHostileEntity<CommonHooded>;
-template class GenericHostileEntity<CommonSatyr>;
-template class GenericHostileEntity<CommonChickenBoy>;
-template class GenericHostileEntity<ElitePlagueCrow>;
-template class GenericHostileEntity<EliteDarkSamurai>;
-template class GenericHostileEntity<BossRedHood>;
-template class GenericHostileEntity<BossNightBorne>;
+template class GenericHostileEntity<CommonHooded, MovementSelectionType::kPathfindingAStar>;
+template class GenericHostileEntity<CommonSatyr, MovementSelectionType::kPathfindingAStar>;
+template class GenericHostileEntity<CommonChickenBoy, MovementSelectionType::kPathfindingAStar>;
+template class GenericHostileEntity<ElitePlagueCrow, MovementSelectionType::kPathfindingAsync>;
+template class GenericHostileEntity<EliteDarkSamurai, MovementSelectionType::kPathfindingAsync>;
+template class GenericHostileEntity<BossRedHood, MovementSelectionType::kPathfindingAsync>;
+template class GenericHostileEntity<BossNightBorne, MovementSelectionType::kPathfindingAsync>;
 template class GenericHostileEntity<Egg>;
 template class GenericHostileEntity<EnergySphere>;
 
 
-DEF_GENERIC_HOSTILE_ENTITY_(ElitePlagueCrow, config::entities::hostile::elite_plague_crow)
-DEF_GENERIC_HOSTILE_ENTITY_(EliteDarkSamurai, config::entities::hostile::elite_dark_samurai)
-DEF_GENERIC_HOSTILE_ENTITY_(CommonHooded, config::entities::hostile::common_hooded)
-DEF_GENERIC_HOSTILE_ENTITY_(CommonSatyr, config::entities::hostile::common_satyr)
-DEF_GENERIC_HOSTILE_ENTITY_(CommonChickenBoy, config::entities::hostile::common_chicken_boy)
-DEF_GENERIC_HOSTILE_ENTITY_(BossRedHood, config::entities::hostile::boss_red_hood)
-DEF_GENERIC_HOSTILE_ENTITY_(BossNightBorne, config::entities::hostile::boos_night_borne)
+DEF_GENERIC_HOSTILE_ENTITY(ElitePlagueCrow, MovementSelectionType::kPathfindingAsync, config::entities::hostile::elite_plague_crow)
+DEF_GENERIC_HOSTILE_ENTITY(EliteDarkSamurai, MovementSelectionType::kPathfindingAsync, config::entities::hostile::elite_dark_samurai)
+DEF_GENERIC_HOSTILE_ENTITY(CommonHooded, MovementSelectionType::kPathfindingAStar, config::entities::hostile::common_hooded)
+DEF_GENERIC_HOSTILE_ENTITY(CommonSatyr, MovementSelectionType::kPathfindingAStar, config::entities::hostile::common_satyr)
+DEF_GENERIC_HOSTILE_ENTITY(CommonChickenBoy, MovementSelectionType::kPathfindingAStar, config::entities::hostile::common_chicken_boy)
+DEF_GENERIC_HOSTILE_ENTITY(BossRedHood, MovementSelectionType::kPathfindingAsync, config::entities::hostile::boss_red_hood)
+DEF_GENERIC_HOSTILE_ENTITY(BossNightBorne, MovementSelectionType::kPathfindingAsync, config::entities::hostile::boos_night_borne)
 DEF_GENERIC_HOSTILE_ENTITY_(Egg, config::entities::hostile::egg)
 DEF_GENERIC_HOSTILE_ENTITY_(EnergySphere, config::entities::hostile::energy_sphere)
\ No newline at end of file
@@ -51,7 +51,7 @@ GenericInteractable<T>::handleCustomEventGET_impl(SDL_Event const& event) {
     IngameDialogueBox::invoke(&IngameDialogueBox::enqueueContents, mDialogues[mProgress]);
     if (mProgress < static_cast<unsigned short int>(mDialogues.size()) - 1) ++mProgress;   // Move towards final state
 
-    if (sSFXName != nullptr && (mProgress & 1)) Mixer::invoke(&Mixer::playSFX, *sSFXName);     
+    if (sSFXName != nullptr && (mProgress & 1)) Mixer::invoke(&Mixer::playSFXAt, *sSFXName, mDestCoords);     
 }
 
 
@@ -138,18 +138,6 @@ void Player::handleCustomEventPOST() const {
 
 void Player::handleCustomEventGET(SDL_Event const& event) {
     switch (event::getCode(event)) {
-        case event::Code::kReq_AttackRegister_GHE_Player:
-            handleCustomEventGET_impl<event::Code::kReq_AttackRegister_GHE_Player>(event);
-            break;
-
-        case event::Code::kReq_AttackInitiate_GHE_Player:
-            handleCustomEventGET_impl<event::Code::kResp_AttackInitiate_GHE_Player>(event);
-            break;
-
-        case event::Code::kReq_MoveInitiate_GHE_Player:
-            handleCustomEventGET_impl<event::Code::kResp_MoveInitiate_GHE_Player>(event);
-            break;
-
         case event::Code::kReq_Teleport_GTE_Player:
             handleCustomEventGET_impl<event::Code::kResp_Teleport_GTE_Player>(event);
             break;
@@ -158,6 +146,23 @@ void Player::handleCustomEventGET(SDL_Event const& event) {
     }
 }
 
+/**
+ * @brief Called by a hostile whose meele attack reaches its final sprite.
+ * @param attributes the attributes of the attacking hostile.
+ * @param destCoords the `destCoords` of the attacking hostile.
+*/
+void Player::onAttackRegistered(EntityAttributes& attributes, SDL_Point const& destCoords) {
+    if (mAnimation == Animation::kDamaged || mAnimation == Animation::kDeath || !attributes.within<EntityAttributes::ID::ARR>(mDestCoords, destCoords)) return;
+
+    if (attributes.attack(mAttributes)) {
+        resetAnimation(Animation::kDeath);
+        Claw::initiateAttack(ProjectileType::kOrthogonalSingle, mDestCoords, { 0, 0 });
+    } else {
+        resetAnimation(Animation::kDamaged);
+        Slash::initiateAttack(ProjectileType::kOrthogonalSingle, mDestCoords, { 0, 0 });
+    }
+}
+
 void Player::handleSFX() const {
     AbstractAnimatedDynamicEntity<Player>::handleSFX();
 
@@ -185,49 +190,109 @@ void Player::handleSFX() const {
 }
 
 /**
- * @brief Calculate path to `level::data.autopilotTargetTile`.
+ * @brief Route towards `level::data.autopilotTargetTile`, following the shared distance field rooted at it, or on levels larger than `config::entities::AutopilotFlowFieldMaxCells`, over the shared abstract graph.
+ * @note On the abstract graph, only the waypoints are computed here, see `refineAutopilotPath()`.
 */
 void Player::onAutopilotToggled(bool onAutopilotStart) {
     if (!onAutopilotStart) {
         Umbra::instantiateEX({});
-        while (!mAutopilotPath.empty()) mAutopilotPath.pop();
+        mAutopilotDestCoords.reset();
+        mAutopilotWaypoints.clear();
+        mAutopilotPath.clear();
         if (mNextVelocity != nullptr) delete mNextVelocity;
         mNextVelocity = nullptr;
         return;
     }
 
-    static auto pathfinder = pathfinders::ASPF<pathfinders::Heuristic::kManhattan, pathfinders::MovementType::k4Directional>(level::data.collisionTilelayer);
-    pathfinder.setBegin({ 0, 0 });
-    pathfinder.setEnd({ static_cast<int>(level::data.collisionTilelayer.front().size()) - 1, static_cast<int>(level::data.collisionTilelayer.size()) - 1 });
+    auto src = pathfinders::Cell::pttocl(mDestCoords);
+    auto dest = pathfinders::Cell::pttocl(level::data.autopilotTargetTile);
+    mIsAutopilotOnFlowField = static_cast<std::size_t>(level::data.tileDestCount.x) * level::data.tileDestCount.y <= config::entities::AutopilotFlowFieldMaxCells;
 
-    auto result = pathfinder.search(pathfinders::Cell::pttocl(mDestCoords), pathfinders::Cell::pttocl(level::data.autopilotTargetTile));
-    if (result.status != pathfinders::Status::kSuccess) return;
+    if (mIsAutopilotOnFlowField) {
+        auto const& field = pathfinders::flowfields.get(dest);
+        auto distance = field.getDistance(src);
+        if (distance == pathfinders::FlowField::kUnreachable || !distance) return;
 
-    mAutopilotPath = result.path;
-    
-    std::vector<level::Data_Generic*> umbraLevelData(result.path.size());
-    for (auto& data : umbraLevelData) {
-        data = new level::Data_Generic(pathfinders::Cell::cltopt(result.path.top()));
-        result.path.pop();
+        mAutopilotDestCoords = mDestCoords;
+
+        // Trace the field down to the target to place the markers
+        std::vector<level::Data_Generic*> umbraLevelData;
+        umbraLevelData.reserve(distance + 1);
+        for (std::optional<pathfinders::Cell> cell = src; cell.has_value(); cell = field.getNextCell(cell.value())) {
+            umbraLevelData.push_back(new level::Data_Generic(pathfinders::Cell::cltopt(cell.value())));
+        }
+        Umbra::instantiateEX(umbraLevelData);
+        return;
+    }
+
+    if (pathfinders::hierarchy.search(src, dest, mAutopilotWaypoints) != pathfinders::Status::kSuccess) return;
+
+    mAutopilotWaypoints.pop_back();   // The current tile
+    mAutopilotPath.clear();
+    mAutopilotDestCoords = mDestCoords;
+    refineAutopilotPath();
+}
+
+/**
+ * @brief Expand the next waypoint into `mAutopilotPath`, then place the markers along the known route.
+ * @note Costs a single in-cluster search per waypoint, spread over the whole route instead of upfront.
+*/
+void Player::refineAutopilotPath() {
+    while (mAutopilotPath.empty() && !mAutopilotWaypoints.empty()) {
+        auto waypoint = mAutopilotWaypoints.back();
+        mAutopilotWaypoints.pop_back();
+
+        switch (pathfinders::hierarchy.refine(pathfinders::Cell::pttocl(mDestCoords), waypoint, mAutopilotPath)) {
+            case pathfinders::Status::kSuccess:
+                mAutopilotPath.pop_back();   // The current tile
+                break;
+
+            case pathfinders::Status::kCoincidents: break;
+
+            default:
+                mAutopilotWaypoints.clear();
+                mAutopilotPath.clear();
+                return;
+        }
     }
+
+    std::vector<level::Data_Generic*> umbraLevelData;
+    umbraLevelData.reserve(mAutopilotPath.size() + mAutopilotWaypoints.size() + 1);
+    umbraLevelData.push_back(new level::Data_Generic(mDestCoords));
+    for (auto it = mAutopilotPath.rbegin(); it != mAutopilotPath.rend(); ++it) umbraLevelData.push_back(new level::Data_Generic(pathfinders::Cell::cltopt(*it)));
+    for (auto it = mAutopilotWaypoints.rbegin(); it != mAutopilotWaypoints.rend(); ++it) umbraLevelData.push_back(new level::Data_Generic(pathfinders::Cell::cltopt(*it)));
     Umbra::instantiateEX(umbraLevelData);
 }
 
 /**
  * @brief Determine player movement on autopilot.
+ * @note On the distance field, the next step is an `O(1)` lookup.
 */
 void Player::handleAutopilotMovement() {
-    if (!isOnAutopilot() || mDestCoords != pathfinders::Cell::cltopt(mAutopilotPath.top())) return;
+    if (!isOnAutopilot() || mDestCoords != mAutopilotDestCoords.value()) return;
 
-    // The current topmost element of the path is the player's current position, so remove it
-    mAutopilotPath.pop();
-    if (mAutopilotPath.empty()) return;
+    std::optional<pathfinders::Cell> nextCell;
+    if (mIsAutopilotOnFlowField) {
+        nextCell = pathfinders::flowfields.get(pathfinders::Cell::pttocl(level::data.autopilotTargetTile)).getNextCell(pathfinders::Cell::pttocl(mDestCoords));
+    } else {
+        if (mAutopilotPath.empty()) refineAutopilotPath();
+        if (!mAutopilotPath.empty()) {
+            nextCell = mAutopilotPath.back();
+            mAutopilotPath.pop_back();
+        }
+    }
 
     onMoveEnd(BehaviouralType::kAutopilot);   // This took more than 1 week to debug
 
-    // After removal, the current topmost element of the path is the player's (supposedly) next position, so base calculations on it
-    // if (mNextVelocity != nullptr) delete mNextVelocity;
-    mNextVelocity = new SDL_Point(pathfinders::Cell::cltopt(mAutopilotPath.top()) - mDestCoords);
+    // Either the target is reached or it is no longer reachable
+    if (!nextCell.has_value()) {
+        onAutopilotToggled(false);
+        return;
+    }
+
+    delete mNextVelocity;
+    mNextVelocity = new SDL_Point(pathfinders::Cell::cltopt(nextCell.value()) - mDestCoords);
+    mAutopilotDestCoords = pathfinders::Cell::cltopt(nextCell.value());
     initiateMove(BehaviouralType::kAutopilot);
 }
 
@@ -312,51 +377,6 @@ Player::handleCustomEventPOST_impl() const {
     event::enqueue(event);
 }
 
-template <event::Code C>
-typename std::enable_if_t<C == event::Code::kReq_AttackRegister_GHE_Player>
-Player::handleCustomEventGET_impl(SDL_Event const& event) {
-    auto data = event::getData<event::Data_Generic>(event);
-
-    if (mAnimation == Animation::kDamaged || mAnimation == Animation::kDeath || !data.attributes->within<EntityAttributes::ID::ARR>(mDestCoords, data.destCoords)) return;
-
-    if (data.attributes->attack(mAttributes)) {
-        resetAnimation(Animation::kDeath);
-        Claw::initiateAttack(ProjectileType::kOrthogonalSingle, mDestCoords, { 0, 0 });
-    } else {
-        resetAnimation(Animation::kDamaged);
-        Slash::initiateAttack(ProjectileType::kOrthogonalSingle, mDestCoords, { 0, 0 });
-    }
-}
-
-template <event::Code C>
-typename std::enable_if_t<C == event::Code::kResp_AttackInitiate_GHE_Player>
-Player::handleCustomEventGET_impl(SDL_Event const& event) {
-    auto data = event::getData<event::Data_Generic>(event);
-
-    if (mAnimation == Animation::kDamaged || mAnimation == Animation::kDeath || !data.attributes->within<EntityAttributes::ID::AIR>(mDestCoords, data.destCoords)) return;
-
-    auto followupEvent = event::instantiate();
-    event::setID(followupEvent, event::getID(event));
-    event::setCode(followupEvent, event::Code::kResp_AttackInitiate_GHE_Player);
-    event::setData(followupEvent, data);
-    event::enqueue(followupEvent);
-}
-
-template <event::Code C>
-typename std::enable_if_t<C == event::Code::kResp_MoveInitiate_GHE_Player>
-Player::handleCustomEventGET_impl(SDL_Event const& event) {
-    auto data = event::getData<event::Data_Generic>(event);
-
-    if (mAnimation == Animation::kDeath) return;
-
-    auto followupEvent = event::instantiate();
-    event::setID(followupEvent, event::getID(event));
-    event::setCode(followupEvent, data.attributes->within<EntityAttributes::ID::MIR>(mDestCoords, data.destCoords) ? event::Code::kResp_MoveInitiate_GHE_Player : event::Code::kResp_MoveTerminate_GHE_Player);
-    data.destCoords = mDestCoords;
-    event::setData(followupEvent, data);
-    event::enqueue(followupEvent);
-}
-
 template <event::Code C>
 typename std::enable_if_t<C == event::Code::kResp_Teleport_GTE_Player>
 Player::handleCustomEventGET_impl(SDL_Event const& event) {
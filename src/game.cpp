@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <string>
 #include <limits>
+#include <thread>
 
 #include <SDL.h>
 #include <SDL_image.h>
@@ -10,6 +11,7 @@
 #include <SDL_mixer.h>
 
 #include <mixer.hpp>
+#include <loader.hpp>
 #include <timers.hpp>
 #include <interface.hpp>
 #include <auxiliaries.hpp>
@@ -19,6 +21,8 @@
 Game::Game(GameInitFlag const& flags, SDL_Rect windowDimension, const int FPS, const std::string title) : mFlags(flags), mWindowDimension(windowDimension), mFPS(FPS), mWindowTitle(title) {}
 
 Game::~Game() {
+    AssetLoader::deinitialize();   // Workers might still be decoding
+
     if (mWindowSurface != nullptr) {
         SDL_FreeSurface(mWindowSurface);
         mWindowSurface = nullptr;
@@ -32,6 +36,8 @@ Game::~Game() {
         mWindow = nullptr;
     }
 
+    UICompositor::deinitialize();   // Before the renderer is destroyed
+    FontService::deinitialize();
     globals::deinitialize();
 
     FPSDisplayTimer::deinitialize();
@@ -45,6 +51,8 @@ Game::~Game() {
     MenuInterface::deinitialize();
     LoadingInterface::deinitialize();
 
+    TimerWheel::deinitialize();   // After every timer owner
+
     globals::gc.clear();
 
     // Quit SDL subsystems
@@ -52,6 +60,8 @@ Game::~Game() {
     SDL_Quit();
     TTF_Quit();
     Mix_Quit();
+
+    globals::archive.unmount();   // Fonts and the like read from it for as long as they live
 }
 
 /**
@@ -61,6 +71,8 @@ Game::~Game() {
 void Game::start() {
     initialize();
     startGameLoop();
+
+    if (IngameInterface::instance != nullptr) IngameInterface::instance->save.flush();   // A save submitted right before exiting would otherwise be lost
 }
 
 /**
@@ -68,6 +80,24 @@ void Game::start() {
  * @note Any `initialize()` methods should be placed here.
 */
 void Game::initialize() {
+    static constexpr auto renderUIComponents = []() {
+        switch (globals::state) {
+            case GameState::kMenu:
+                MenuInterface::invoke(&MenuInterface::renderComponents);
+                break;
+
+            case GameState::kGameOver:
+                GameOverInterface::invoke(&GameOverInterface::renderComponents);
+                break;
+
+            default: break;
+        }
+
+        // Dependencies that should render regardless of game state
+        FPSOverlay::invoke(&FPSOverlay::render);
+        ExitText::invoke(&ExitText::render);
+    };
+
     // Initialize SDL subsystems
     SDL_Init(mFlags.lSDL);
     IMG_Init(mFlags.lIMG);
@@ -76,13 +106,18 @@ void Game::initialize() {
 
     for (const auto& pair: mFlags.hints) SDL_SetHint(pair.first.c_str(), pair.second.c_str());
 
+    globals::archive.mount(config::path::archive);   // Before any asset is loaded. Assets are read from loose files if there is no archive
+
     mWindow = SDL_CreateWindow(mWindowTitle.c_str(), mWindowDimension.x, mWindowDimension.y, mWindowDimension.w, mWindowDimension.h, mFlags.window);
-    mWindowIcon = IMG_Load(mWindowIconPath.generic_string().c_str());
+    mWindowIcon = IMG_Load_RW(globals::archive.open(mWindowIconPath), 1);
     SDL_SetWindowIcon(mWindow, mWindowIcon);
     mWindowID = SDL_GetWindowID(mWindow);
     globals::renderer = SDL_CreateRenderer(mWindow, -1, mFlags.renderer);
 
     event::initialize();
+
+    AssetLoader::instantiate(std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, config::game::maxAssetLoaderWorkerCount));   // Before any dependency submits to it
+    AssetLoader::invoke(&AssetLoader::markPhase, "subsystems");
     
     // Initialize dependencies
     IngameInterface::initialize();
@@ -92,20 +127,25 @@ void Game::initialize() {
 
     FPSDisplayTimer::instantiate();
     FPSControlTimer::instantiate();
+    TimerWheel::instantiate();
+    FontService::instantiate();   // Before any text component
     FPSOverlay::instantiate(config::components::fps_overlay::initializer);
     ExitText::instantiate(config::components::exit_text::initializer);
+    UICompositor::instantiate(renderUIComponents);
 
     Mixer::instantiate();
+    AssetLoader::invoke(&AssetLoader::markPhase, "mixer");
 
     IngameInterface::instantiate();
     MenuInterface::instantiate();   // Requires instantiation of `Player` and `IngameMapHandler`
     LoadingInterface::instantiate();
     GameOverInterface::instantiate();
+
+    AssetLoader::invoke(&AssetLoader::markPhase, "initialize");
 }
 
 /**
  * @brief Start the game loop.
- * @todo Manually cap frame rate (VSync disabled)
 */
 void Game::startGameLoop() {
     // Serve as partial initialization for certain attributes of certain classes
@@ -115,17 +155,27 @@ void Game::startGameLoop() {
     FPSDisplayTimer::invoke(&FPSDisplayTimer::start);
 
     while (globals::state != GameState::kExit) {
-        // Control frame rate
-        FPSControlTimer::invoke(&FPSControlTimer::start);
+        FrameClock::tick();   // The only clock sample of the frame
 
         // Calculate frame rate
         FPSDisplayTimer::invoke(&FPSDisplayTimer::calculateFPS);
         if (FPSDisplayTimer::instance->mAccumulatedFrames % FPSOverlay::kAnimationUpdateRate == 0) FPSOverlay::invoke(&FPSOverlay::editContent, config::components::fps_overlay::prefix + utils::dtos(FPSDisplayTimer::instance->mAverageFPS, config::components::fps_overlay::precision));
 
-        // Main flow
-        handleDependencies();
-        handleEvents();
+        // Main flow: simulate in fixed ticks, then render once, interpolated between the last two ticks
+        while (globals::state != GameState::kExit && FrameClock::step()) {
+            handleDependencies();
+            handleEvents();
+        }
+        handleWindowChange();
         render();
+        if (FPSDisplayTimer::instance->mAccumulatedFrames % FPSOverlay::kAnimationUpdateRate == 0) reportFrame();
+
+        static bool isFirstFrame = true;
+        if (isFirstFrame) AssetLoader::invoke(&AssetLoader::markPhase, "first frame");
+        isFirstFrame = false;
+
+        // Create textures of assets decoded in the background, a few at a time
+        AssetLoader::invoke(&AssetLoader::finalize, config::game::assetFinalizeBudgetMilliseconds);
 
         // Control frame rate
         FPSControlTimer::invoke(&FPSControlTimer::controlFPS);
@@ -142,6 +192,7 @@ void Game::startGameLoop() {
  * @note Any `render()` methods should be placed here.
 */
 void Game::render() const {
+    globals::batcher.resetStats();
     SDL_RenderClear(globals::renderer);
 
     switch (globals::state) {
@@ -165,13 +216,32 @@ void Game::render() const {
         default: break;
     }
 
-    // Dependencies that should render regardless of game state
-    FPSOverlay::invoke(&FPSOverlay::render);
-    ExitText::invoke(&ExitText::render);
+    UICompositor::invoke(&UICompositor::render);   // Components, retained across frames
 
     SDL_RenderPresent(globals::renderer);
 }
 
+/**
+ * @brief Log figures of the frame just rendered, for profiling.
+ * @note No-op unless `config::enable_frame_report` is set.
+*/
+void Game::reportFrame() const {
+    if constexpr(!config::enable_frame_report) return;
+
+    auto const& batcherStats = globals::batcher.getStats();
+    SDL_Log("Sprites: %zu in %zu batches", batcherStats.sprites, batcherStats.batches);
+
+    if (UICompositor::instance != nullptr) {
+        auto const& compositorStats = UICompositor::instance->getStats();
+        SDL_Log("UI: %zu pixels recomposited across %zu rects", compositorStats.recompositedPixels, compositorStats.recompositedRects);
+    }
+
+    if ((globals::state == GameState::kIngamePlaying || globals::state == GameState::kIngameDialogue) && IngameViewHandler::instance != nullptr) {
+        auto const& stats = IngameViewHandler::instance->getCullingStats();
+        SDL_Log("Entities: %zu drawn, %zu culled", stats.drawn, stats.culled);
+    }
+}
+
 /**
  * @brief Called when switching to a new level.
 */
@@ -186,6 +256,7 @@ void Game::onWindowChange() {
     mWindowSurface = SDL_GetWindowSurface(mWindow);
     SDL_GetWindowSize(mWindow, &globals::windowSize.x, &globals::windowSize.y);
 
+    UICompositor::invoke(&UICompositor::onWindowChange);
     FPSOverlay::invoke(&FPSOverlay::onWindowChange);
     ExitText::invoke(&ExitText::onWindowChange);
 
@@ -198,6 +269,17 @@ void Game::onWindowChange() {
     SDL_UpdateWindowSurface(mWindow);
 }
 
+/**
+ * @brief Apply a pending resize once the window has stopped changing for `config::game::windowChangeSettleMilliseconds`.
+ * @note A drag-resize emits a burst of events, each of which would otherwise reload every font and texture sized after the window. Only the final size is applied, since `onWindowChange()` queries it anew.
+*/
+void Game::handleWindowChange() {
+    if (!mIsWindowChangePending || FrameClock::getMilliseconds() - mLastWindowChangeMilliseconds < config::game::windowChangeSettleMilliseconds) return;
+
+    mIsWindowChangePending = false;
+    onWindowChange();
+}
+
 /**
  * @brief Handle everything about entities.
  * @note Some `Mixer::invoke(&Mixer::handleGameStateChange)` has been commented out to prevent overlap with `onLevelChange()`.
@@ -218,6 +300,7 @@ void Game::handleDependencies() {
 
         case (GameState::kLoading | GameState::kIngamePlaying):
             LoadingInterface::invoke(&LoadingInterface::initiateTransition, GameState::kIngamePlaying);
+            AssetLoader::invoke(&AssetLoader::waitAll);   // The level might instantiate any entity
             onLevelChange();
             onWindowChange();
             break;
@@ -295,7 +378,8 @@ void Game::handleWindowEvent(SDL_Event const& event) {
     if (event.window.windowID != mWindowID) return;
     switch (event.window.event) {
         case SDL_WINDOWEVENT_SIZE_CHANGED:
-            onWindowChange();
+            mIsWindowChangePending = true;   // Deferred to `handleWindowChange()`
+            mLastWindowChangeMilliseconds = FrameClock::getMilliseconds();
             break;
 
         default: break;
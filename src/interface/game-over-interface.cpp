@@ -19,9 +19,11 @@ void GameOverInterface::deinitialize() {
     Singleton<GameOverInterface>::deinitialize();
 }
 
+/**
+ * @note Components are rendered by `UICompositor` on top.
+*/
 void GameOverInterface::render() const {
     renderBackground();
-    renderComponents();
 }
 
 void GameOverInterface::renderBackground() const {
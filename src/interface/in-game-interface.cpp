@@ -1,11 +1,15 @@
 #include <interface.hpp>
 
 #include <array>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <memory>
 
 #include <entities.hpp>
 #include <mixer.hpp>
 #include <auxiliaries.hpp>
+#include <zlib/zlib.h>
 
 
 std::size_t IngameInterface::ProgressHandler::get() const {
@@ -21,103 +25,179 @@ void IngameInterface::ProgressHandler::set(std::size_t value) const {
     else it->second = value;
 }
 
-void IngameInterface::ProgressHandler::loadfromjson(json const& data) const {
-    auto progress_j = data.find("progress"); if (progress_j == data.end()) return;
-    auto progress_v = progress_j.value(); if (!progress_v.is_object()) return;
+/**
+ * @brief Restore the last save. A corrupt save is skipped in favour of the one left by an interrupted write if any, then of the JSON export, which is also how saves predating the binary format are read.
+*/
+void IngameInterface::SaveHandler::loadfromfile() const {
+    mWriter.flush();   // Read back the latest save, not the one before
 
-    auto impl = [&](level::Name ln) -> void {
-        auto ln_j = progress_v.find(std::to_string(static_cast<unsigned int>(ln))); if (ln_j == progress_v.end()) return;
-        mProgress.insert(std::make_pair(ln, ln_j.value()));
-    };
+    auto snapshot = readfromfile(mPath);
 
-    impl(level::Name::kLevelPrelude);
-    impl(level::Name::kLevelPrologueMovement);
-    impl(level::Name::kLevelPrologueCombat);
-
-    impl(level::Name::kLevelSuffering_empty);
-    impl(level::Name::kLevelSuffering_1_0);
-    impl(level::Name::kLevelSuffering_1_1);
-    impl(level::Name::kLevelSuffering_2_0);
-    impl(level::Name::kLevelSuffering_2_1);
-    impl(level::Name::kLevelSuffering_3_0);
-    impl(level::Name::kLevelSuffering_3_1);
-    impl(level::Name::kLevelSuffering_3_2);
-
-    impl(level::Name::kLevelStatusQuo_0);
-    impl(level::Name::kLevelStatusQuo_1);
-    impl(level::Name::kLevelStatusQuo_2);
-    impl(level::Name::kLevelStatusQuo_3);
-    impl(level::Name::kLevelStatusQuo_4);
-
-    impl(level::Name::kLevelRoundtable_empty);
-    impl(level::Name::kLevelRoundtable_first);
-    impl(level::Name::kLevelRoundtable_second);
-    impl(level::Name::kLevelRoundtable_final);
-
-    impl(level::Name::kLevelInterlude);
-
-    impl(level::Name::kLevelWhiteSpace);
+    if (!snapshot.has_value()) {
+        auto temporaryPath = mPath;
+        temporaryPath += ".tmp";   // Complete but not yet renamed, should `FileWriter::commit()` have been interrupted
+        snapshot = readfromfile(temporaryPath);
+        if (snapshot.has_value()) SDL_Log("Restored save from %s", temporaryPath.string().c_str());
+    }
+
+    auto JSONPath = std::filesystem::path(mPath).replace_extension(".json");
+    if (!snapshot.has_value() && std::filesystem::exists(JSONPath)) {
+        if (std::filesystem::exists(mPath)) SDL_Log("Restoring save from %s, which might predate the corrupt one", JSONPath.string().c_str());
+        json data;
+        utils::fetch(JSONPath, data);
+        snapshot = fromjson(data);
+    }
+
+    if (snapshot.has_value()) restore(snapshot.value());
 }
 
-json& IngameInterface::ProgressHandler::savetojson(json& data) const {
-    for (const auto& pair : mProgress) data["progress"][std::to_string(static_cast<unsigned int>(pair.first))] = pair.second;
-    return data;
+void IngameInterface::SaveHandler::clear() const {
+    IngameMapHandler::invoke(&IngameMapHandler::changeLevel, config::interface::levelName);
+    mPL.reset();
+    mProgress.clear();
 }
 
-void IngameInterface::SaveHandler::loadfromfile() const {
-    if (!std::filesystem::exists(config::interface::savePath)) return;
+IngameInterface::SaveHandler::Snapshot IngameInterface::SaveHandler::snapshot() const {
+    return { IngameMapHandler::instance->getLevel(), Player::instance->mDestCoords, mProgress.snapshot() };
+}
 
-    json data;
-    utils::fetch(mPath, data);
-    if (data.empty()) return;
+void IngameInterface::SaveHandler::restore(Snapshot const& snapshot) const {
+    IngameMapHandler::invoke(&IngameMapHandler::changeLevel, snapshot.level);
+    mPL = snapshot.player;
+    mProgress.restore(snapshot.progress);
+}
 
-    auto ln = level::hstoln(data["level"]);
-    if (ln.has_value()) IngameMapHandler::invoke(&IngameMapHandler::changeLevel, ln.value());
+/**
+ * @brief Snapshot the current state, then leave encoding and writing to `mWriter`.
+*/
+void IngameInterface::SaveHandler::savetofile() const {
+    auto snapshot = std::make_shared<const Snapshot>(this->snapshot());
 
-    mPL = std::make_optional<SDL_Point>({ data["player"]["x"], data["player"]["y"] });
+    mWriter.submit(mPath, [snapshot]() { return encode(*snapshot); });
+    if constexpr(config::enable_save_json_export) mWriter.submit(std::filesystem::path(mPath).replace_extension(".json"), [snapshot]() { return tojson(*snapshot).dump(2, ' ', true, json::error_handler_t::strict); });
+}
 
-    mProgress.clear();
-    mProgress.loadfromjson(data);
+std::string IngameInterface::SaveHandler::encode(Snapshot const& snapshot) {
+    std::string payload;
+    auto append = [&](auto value) { payload.append(reinterpret_cast<char const*>(&value), sizeof(value)); };
+
+    append(static_cast<Uint32>(snapshot.level));
+    append(static_cast<Sint32>(snapshot.player.x));
+    append(static_cast<Sint32>(snapshot.player.y));
+    append(static_cast<Uint32>(snapshot.progress.size()));
+    for (auto const& pair : snapshot.progress) {
+        append(static_cast<Uint32>(pair.first));
+        append(static_cast<Uint32>(pair.second));
+    }
+
+    Header header = { kMagic, kVersion, 0, static_cast<Uint32>(payload.size()), static_cast<Uint32>(crc32(0, reinterpret_cast<Bytef const*>(payload.data()), static_cast<uInt>(payload.size()))) };
+    return std::string(reinterpret_cast<char const*>(&header), sizeof(header)) + payload;
 }
 
-void IngameInterface::SaveHandler::clear() const {
-    IngameMapHandler::invoke(&IngameMapHandler::changeLevel, config::interface::levelName);
-    mPL.reset();
-    mProgress.clear();
+/**
+ * @return `std::nullopt` if there is no save at `path`, or if it fails validation, which is logged.
+*/
+std::optional<IngameInterface::SaveHandler::Snapshot> IngameInterface::SaveHandler::readfromfile(std::filesystem::path const& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return std::nullopt;
+
+    std::vector<char> data(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    auto snapshot = file.read(data.data(), data.size()) ? decode(data) : std::nullopt;
+
+    if (!snapshot.has_value()) SDL_Log("Ignoring corrupt save at %s", path.string().c_str());
+    return snapshot;
 }
 
-json IngameInterface::SaveHandler::savetojson() const {
-    json data;
+/**
+ * @return `std::nullopt` if `data` is truncated, corrupted, or of another version.
+*/
+std::optional<IngameInterface::SaveHandler::Snapshot> IngameInterface::SaveHandler::decode(std::vector<char> const& data) {
+    Header header;
+    if (data.size() < sizeof(header)) return std::nullopt;
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    auto payload = data.data() + sizeof(header);
+    if (header.magic != kMagic || header.version != kVersion || header.payloadSize != data.size() - sizeof(header)) return std::nullopt;
+    if (header.checksum != crc32(0, reinterpret_cast<Bytef const*>(payload), static_cast<uInt>(header.payloadSize))) return std::nullopt;
+
+    std::size_t offset = 0;
+    auto extract = [&](auto& value) {
+        if (offset + sizeof(value) > header.payloadSize) return false;
+        std::memcpy(&value, payload + offset, sizeof(value));
+        offset += sizeof(value);
+        return true;
+    };
+
+    Uint32 level, progressCount;
+    Sint32 x, y;
+    if (!extract(level) || !extract(x) || !extract(y) || !extract(progressCount)) return std::nullopt;
 
-    data["level"] = IngameMapHandler::instance->getLevel();
-    data["player"]["x"] = Player::instance->mDestCoords.x;
-    data["player"]["y"] = Player::instance->mDestCoords.y;
+    auto ln = level::hstoln(level); if (!ln.has_value()) return std::nullopt;
+    Snapshot snapshot = { ln.value(), { x, y }, {} };
 
-    mProgress.savetojson(data);
+    for (Uint32 i = 0; i < progressCount; ++i) {
+        Uint32 progressLevel, progress;
+        if (!extract(progressLevel) || !extract(progress)) return std::nullopt;
+
+        auto progressLn = level::hstoln(progressLevel);
+        if (progressLn.has_value()) snapshot.progress[progressLn.value()] = progress;
+    }
+
+    return snapshot;
+}
+
+json IngameInterface::SaveHandler::tojson(Snapshot const& snapshot) {
+    json data;
+
+    data["level"] = snapshot.level;
+    data["player"]["x"] = snapshot.player.x;
+    data["player"]["y"] = snapshot.player.y;
+    for (auto const& pair : snapshot.progress) data["progress"][std::to_string(static_cast<unsigned int>(pair.first))] = pair.second;
 
     return data;
 }
 
-void IngameInterface::SaveHandler::savetofile(json const& data) const {
-    std::ofstream file;
+std::optional<IngameInterface::SaveHandler::Snapshot> IngameInterface::SaveHandler::fromjson(json const& data) {
+    auto level_j = data.find("level"); if (level_j == data.end()) return std::nullopt;
+    auto level_v = level_j.value(); if (!level_v.is_number_unsigned()) return std::nullopt;
+    auto ln = level::hstoln(level_v); if (!ln.has_value()) return std::nullopt;
+
+    auto player_j = data.find("player"); if (player_j == data.end()) return std::nullopt;
+    auto player_v = player_j.value(); if (!player_v.is_object()) return std::nullopt;
+    auto x_j = player_v.find("x"); if (x_j == player_v.end() || !x_j.value().is_number_integer()) return std::nullopt;
+    auto y_j = player_v.find("y"); if (y_j == player_v.end() || !y_j.value().is_number_integer()) return std::nullopt;
+
+    Snapshot snapshot = { ln.value(), { x_j.value(), y_j.value() }, {} };
 
-    file.open(mPath, std::ofstream::out);
-    if (!file.is_open()) return;
+    auto progress_j = data.find("progress"); if (progress_j == data.end()) return snapshot;
+    auto progress_v = progress_j.value(); if (!progress_v.is_object()) return snapshot;
 
-    file << data.dump(2, ' ', true, json::error_handler_t::strict);   // Should move into `config::interface` ?
-    file.close();
+    for (auto it = progress_v.begin(); it != progress_v.end(); ++it) {
+        if (!it.value().is_number_unsigned()) continue;
+        auto progressLn = level::hstoln(static_cast<unsigned int>(std::strtoul(it.key().c_str(), nullptr, 10)));
+        if (progressLn.has_value()) snapshot.progress[progressLn.value()] = it.value();
+    }
+
+    return snapshot;
 }
 
 IngameInterface::IngameInterface() : save(mProgress,  config::interface::savePath) {
-    static constexpr auto renderIngameDependencies = []() {
-        Invoker<IngameMapHandler, NON_INTERACTABLES, INTERACTABLES, TELEPORTERS, HOSTILES, SURGE_PROJECTILES, Player>::invoke_render();
+    static constexpr auto renderIngameDependencies = [](SDL_Rect const& cullingRect) {
+        IngameMapHandler::invoke(&IngameMapHandler::renderWithin, cullingRect);
+        auto drawnCount = Invoker<NON_INTERACTABLES, INTERACTABLES, TELEPORTERS, HOSTILES, SURGE_PROJECTILES>::invoke_renderWithin(cullingRect);
+        Player::invoke(&Player::render);   // Always in view, being the camera target
+        globals::batcher.flush(globals::renderer);   // Before `IngameViewHandler` resets the clip rect
+
+        return IngameViewHandler::CullingStats{ drawnCount + 1, Invoker<NON_INTERACTABLES, INTERACTABLES, TELEPORTERS, HOSTILES, SURGE_PROJECTILES>::count() - drawnCount };
     };
 
     IngameDialogueBox::instantiate(config::components::dialogue_box::initializer);
 
+    Player::awaitInitialize();   // The only tileset required before entering a level
     Player::instantiate(SDL_Point{});   // This is required for below instantiations
     IngameMapHandler::instantiate(config::interface::levelName);
-    IngameViewHandler::instantiate(renderIngameDependencies, Player::instance->mDestRect);
+    IngameViewHandler::instantiate(renderIngameDependencies, Player::instance->mInterpolatedDestRect);   // Follow the rendered position, otherwise the player would jitter against the camera
 }
 
 /**
@@ -127,11 +207,16 @@ void IngameInterface::deinitialize() {
     Invoker<IngameMapHandler, IngameViewHandler, Player, NON_INTERACTABLES, PlaceholderInteractable, INTERACTABLES, PlaceholderTeleporter, TELEPORTERS, HOSTILES, SURGE_PROJECTILES, IngameDialogueBox>::invoke_deinitialize();
 }
 
+/**
+ * @note Entity tilesets are loaded in the background, see `AssetLoader`.
+*/
 void IngameInterface::initialize() {
-    Invoker<IngameMapHandler, Player, NON_INTERACTABLES, PlaceholderInteractable, INTERACTABLES, PlaceholderTeleporter, TELEPORTERS, HOSTILES, SURGE_PROJECTILES>::invoke_initialize();
+    IngameMapHandler::initialize();
+    Invoker<Player, NON_INTERACTABLES, PlaceholderInteractable, INTERACTABLES, PlaceholderTeleporter, TELEPORTERS, HOSTILES, SURGE_PROJECTILES>::invoke_initializeAsync();
 }
 
 void IngameInterface::render() const {
+    Invoker<NON_INTERACTABLES, INTERACTABLES, TELEPORTERS, HOSTILES, SURGE_PROJECTILES, Player>::invoke_interpolateDestRect(FrameClock::getInterpolation());   // Prior to culling, which follows the interpolated camera
     IngameViewHandler::invoke(&IngameViewHandler::render);
 
     switch (globals::state) {
@@ -242,10 +327,12 @@ void IngameInterface::handleCustomEventGET(SDL_Event const& event) const {
  * @note `GameState::kIngamePlaying` only.
 */
 void IngameInterface::handleCustomEventPOST() const {
-    Invoker<Player, PlaceholderTeleporter, TELEPORTERS, HOSTILES, SURGE_PROJECTILES>::invoke_handleCustomEventPOST();
+    Invoker<Player, PlaceholderTeleporter, TELEPORTERS, SURGE_PROJECTILES>::invoke_handleCustomEventPOST();
 }
 
 void IngameInterface::handleDependencies() const {
+    Invoker<NON_INTERACTABLES, INTERACTABLES, TELEPORTERS, HOSTILES, SURGE_PROJECTILES, Player>::invoke_savePrevDestRect();   // Also while entities are frozen, so that interpolation comes to rest
+
     switch (globals::state) {
         case GameState::kIngamePlaying:
             handleEntitiesInteraction();
@@ -266,9 +353,13 @@ void IngameInterface::handleDependencies() const {
  * @brief Handle all entities movements & animation updates.
 */
 void IngameInterface::handleEntitiesInteraction() const {
-    Invoker<NON_INTERACTABLES, INTERACTABLES, TELEPORTERS, HOSTILES, SURGE_PROJECTILES, Player>::invoke_updateAnimation();
+    TimerWheel::invoke(&TimerWheel::advance);   // Fire entity timers at the point they used to be polled
+    Invoker<NON_INTERACTABLES, INTERACTABLES, TELEPORTERS>::invoke_updateAnimationWithin(IngameViewHandler::instance->getCullingRect());   // Purely cosmetic, paused while out of view
+    Invoker<HOSTILES, SURGE_PROJECTILES, Player>::invoke_updateAnimation();   // Animations drive gameplay e.g. attacks land on the final sprite, so these run regardless
     Invoker<SURGE_PROJECTILES>::invoke_handleInstantiation();
     Player::invoke(&Player::handleAutopilotMovement);   // Autopilot
+    pathfinders::service.collect();   // Publish asynchronous searches at a fixed point, before any entity reads them
+    Invoker<HOSTILES>::invoke_handleDecision(PlayerSnapshot{ Player::instance->mDestCoords, Player::instance->mAnimation });   // Batched AI pass
     Invoker<HOSTILES, Player>::invoke_move();
 }
 
@@ -288,6 +379,7 @@ void IngameInterface::handleLevelSpecifics() const {
 }
 
 void IngameInterface::handleEntitiesSFX() const {
+    Mixer::invoke(&Mixer::setListenerCoords, Player::instance->mDestCoords);
     Invoker<Player, HOSTILES>::invoke_handleSFX();
 }
 
@@ -1,5 +1,6 @@
 #include <interface.hpp>
 
+#include <algorithm>
 #include <filesystem>
 #include <vector>
 
@@ -11,10 +12,7 @@
 IngameMapHandler::IngameMapHandler(const level::Name levelName) : AbstractInterface<IngameMapHandler>(), mLevelName(levelName) {}
 
 IngameMapHandler::~IngameMapHandler() {
-    if (mGrayscaleTexture != nullptr) {
-        SDL_DestroyTexture(mGrayscaleTexture);
-        mGrayscaleTexture = nullptr;
-    }
+    clearGrayscaleTilesets();
 }
 
 void IngameMapHandler::initialize() {
@@ -24,33 +22,36 @@ void IngameMapHandler::initialize() {
 }
 
 void IngameMapHandler::render() const {
-    SDL_RenderCopy(globals::renderer, isOnGrayscale ? mGrayscaleTexture : mTexture, nullptr, nullptr);
+    renderWithin({ 0, 0, mTextureSize.x, mTextureSize.y });
+}
+
+/**
+ * @brief Render the portion of the level that intersects `rect`, in level pixels, through `globals::batcher` and its current transform.
+ * @note Flushes `globals::batcher`, since tiles are layered by tilelayer and would otherwise be sorted above ordered quads e.g. entities.
+*/
+void IngameMapHandler::renderWithin(SDL_Rect const& rect) const {
+    renderBackground(rect);
+    renderLevelTilelayers(rect);
+    globals::batcher.flush(globals::renderer);
 }
 
 /**
- * @brief Populate `level` members and re-render `texture`.
- * @note The `grayscaleTexture` block must be at THAT exact location i.e. before resetting render-target else undefined behaviour would be encountered.
+ * @brief Populate `level` members, then resolve tiles to their tilesets.
+ * @note Tiles are drawn in camera space every frame, so that fill cost and VRAM scale with the window rather than the level.
 */
 void IngameMapHandler::onLevelChange() {
     loadLevel();
 
-    if (mTexture != nullptr) SDL_DestroyTexture(mTexture);
     mTextureSize = {
         level::data.tileDestCount.x * level::data.tileDestSize.x,
         level::data.tileDestCount.y * level::data.tileDestSize.y,
-    };
-
-    mTexture = SDL_CreateTexture(globals::renderer, SDL_PixelFormatEnum::SDL_PIXELFORMAT_RGBA32, SDL_TextureAccess::SDL_TEXTUREACCESS_TARGET | SDL_TextureAccess::SDL_TEXTUREACCESS_STATIC, mTextureSize.x, mTextureSize.y);
+    };   // Level size in pixels; `mTexture` is left unused
 
-    renderToTexture();
+    loadTileSprites();
+    loadGrayscaleTilesets();
 }
 
-void IngameMapHandler::onWindowChange() {
-    #if defined(_WIN64) || defined(_WIN32) || defined(_WIN16)
-    // Weird windows-specific bug, don't know how to fix, temporary patch adversely affects performance (which scales proportionally with level size)
-    renderToTexture();
-    #endif
-}
+void IngameMapHandler::onWindowChange() {}   // Nothing is pre-rendered at window size
 
 void IngameMapHandler::handleKeyBoardEvent(SDL_Event const& event) {
     switch (event.key.keysym.sym) {
@@ -77,53 +78,31 @@ void IngameMapHandler::changeLevel(const level::Name levelName_) {
 */
 void IngameMapHandler::loadLevel() const {
     auto kLevelPath = sLevelMap[mLevelName];
-    if (!kLevelPath.has_value() || !std::filesystem::exists(kLevelPath.value())) return;
+    if (!kLevelPath.has_value() || !globals::archive.exists(kLevelPath.value())) return;
     
     json JSONLevelData;
     utils::fetch(kLevelPath.value().string(), JSONLevelData);
     level::data.load(JSONLevelData);
 }
 
-void IngameMapHandler::renderToTexture() {
-    auto cachedRenderTarget = SDL_GetRenderTarget(globals::renderer);
-    SDL_SetRenderTarget(globals::renderer, mTexture);
-    SDL_RenderClear(globals::renderer);
-
-    renderBackground();
-    renderLevelTilelayers();
-
-    if (mGrayscaleTexture != nullptr) SDL_DestroyTexture(mGrayscaleTexture);
-    mGrayscaleTexture = utils::createGrayscaleTexture(globals::renderer, mTexture, config::interface::grayscaleIntensity);
-
-    SDL_SetRenderTarget(globals::renderer, cachedRenderTarget);
-}
-
-/**
- * @brief Fill the window with the tileset's black to achieve a seamless feel.
-*/
-void IngameMapHandler::renderBackground() const {
-    utils::setRendererDrawColor(globals::renderer, level::data.backgroundColor);
-    SDL_RenderFillRect(globals::renderer, nullptr);
-}
-
 /**
- * @brief Render the static portions of a level to `texture`.
+ * @brief Resolve every tile of every tilelayer to its tileset texture and source rect.
+ * @note Called once per level, so that rendering a frame performs no tileset lookup.
 */
-void IngameMapHandler::renderLevelTilelayers() const {
-    SDL_Rect GID_SrcRect, GID_DestRect;
-    SDL_Texture* GID_Texture = nullptr;   // Assign-only
+void IngameMapHandler::loadTileSprites() {
+    mTileSprites.clear();
+    mTileSpriteOffsets.clear();
+    mTileSpriteOffsets.reserve(level::data.tileDestCount.x * level::data.tileDestCount.y + 1);
 
     utils::LRUCache<tile::GID, tile::Data_TilelayerTileset> cache(config::interface::LRUCacheSize);   // Aims to reduce the number of calls to `Data_TilelayerTilesets::operator[]` which is essentially `std::lower_bound` which is `O(log(n))` time complexity
-
-    GID_DestRect.x = GID_DestRect.y = 0;
-    GID_DestRect.w = level::data.tileDestSize.x;
-    GID_DestRect.h = level::data.tileDestSize.y;
-
     tile::Data_TilelayerTileset tilesetData;
 
     for (int y = 0; y < level::data.tileDestCount.y; ++y) {
         for (int x = 0; x < level::data.tileDestCount.x; ++x) {
-            for (const auto& gid : level::data.tiles[y][x]) {
+            mTileSpriteOffsets.push_back(mTileSprites.size());
+
+            for (std::size_t layerIndex = 0; layerIndex < level::data.tiles[y][x].size(); ++layerIndex) {
+                auto gid = level::data.tiles[y][x][layerIndex];
                 if (!gid) continue;   // A GID value of `0` represents an "empty" tile i.e. associated with no tileset
 
                 auto cache_result = cache.at(gid);   // O(1) time complexity
@@ -137,26 +116,106 @@ void IngameMapHandler::renderLevelTilelayers() const {
 
                 if (tilesetData.getProperty("norender") == "true") continue;   // GID is for non-render purposes e.g. collision
 
-                GID_Texture = tilesetData.texture;
-                GID_SrcRect = {
-                    ((gid - tilesetData.firstGID) % tilesetData.srcCount.x) * tilesetData.srcSize.x,
-                    ((gid - tilesetData.firstGID) / tilesetData.srcCount.x) * tilesetData.srcSize.y,
-                    tilesetData.srcSize.x,
-                    tilesetData.srcSize.y,
-                };
-
-                SDL_RenderCopy(globals::renderer, GID_Texture, &GID_SrcRect, &GID_DestRect);
+                mTileSprites.push_back({
+                    tilesetData.texture,
+                    {
+                        ((gid - tilesetData.firstGID) % tilesetData.srcCount.x) * tilesetData.srcSize.x,
+                        ((gid - tilesetData.firstGID) / tilesetData.srcCount.x) * tilesetData.srcSize.y,
+                        tilesetData.srcSize.x,
+                        tilesetData.srcSize.y,
+                    },
+                    static_cast<int>(layerIndex),
+                });
             }
-
-            GID_DestRect.x += GID_DestRect.w;
         }
-
-        GID_DestRect.x = 0;
-        GID_DestRect.y += GID_DestRect.h;
     }
 
+    mTileSpriteOffsets.push_back(mTileSprites.size());
     cache.clear();
 }
 
+/**
+ * @brief Create a grayscaled version of every tileset texture in use, in lieu of grayscaling a level-sized texture.
+ * @note `utils::createGrayscaleTexture()` reads from the render target, hence the intermediate tileset-sized target.
+*/
+void IngameMapHandler::loadGrayscaleTilesets() {
+    clearGrayscaleTilesets();
+
+    auto cachedRenderTarget = SDL_GetRenderTarget(globals::renderer);
+
+    for (auto const& sprite : mTileSprites) {
+        if (sprite.texture == nullptr || mGrayscaleTilesets.find(sprite.texture) != mGrayscaleTilesets.end()) continue;
 
-level::Map IngameMapHandler::sLevelMap;
\ No newline at end of file
+        SDL_Point size;
+        SDL_QueryTexture(sprite.texture, nullptr, nullptr, &size.x, &size.y);
+        auto target = SDL_CreateTexture(globals::renderer, SDL_PixelFormatEnum::SDL_PIXELFORMAT_RGBA32, SDL_TextureAccess::SDL_TEXTUREACCESS_TARGET, size.x, size.y);
+        if (target == nullptr) continue;
+
+        SDL_SetRenderTarget(globals::renderer, target);
+        SDL_SetRenderDrawColor(globals::renderer, 0, 0, 0, 0);
+        SDL_RenderClear(globals::renderer);
+
+        SDL_BlendMode blendMode;
+        SDL_GetTextureBlendMode(sprite.texture, &blendMode);
+        SDL_SetTextureBlendMode(sprite.texture, SDL_BLENDMODE_NONE);   // Preserve transparency
+        SDL_RenderCopy(globals::renderer, sprite.texture, nullptr, nullptr);
+        SDL_SetTextureBlendMode(sprite.texture, blendMode);
+
+        auto grayscaleTexture = utils::createGrayscaleTexture(globals::renderer, target, config::interface::grayscaleIntensity);
+        if (grayscaleTexture != target) SDL_DestroyTexture(target);
+        mGrayscaleTilesets[sprite.texture] = grayscaleTexture;
+    }
+
+    SDL_SetRenderTarget(globals::renderer, cachedRenderTarget);
+}
+
+void IngameMapHandler::clearGrayscaleTilesets() {
+    for (auto& pair : mGrayscaleTilesets) if (pair.second != nullptr) SDL_DestroyTexture(pair.second);
+    mGrayscaleTilesets.clear();
+}
+
+/**
+ * @brief Fill the level with the tileset's black to achieve a seamless feel.
+*/
+void IngameMapHandler::renderBackground(SDL_Rect const& rect) const {
+    SDL_Rect levelRect = { 0, 0, mTextureSize.x, mTextureSize.y }, backgroundRect;
+    if (!SDL_IntersectRect(&rect, &levelRect, &backgroundRect)) return;
+
+    backgroundRect = globals::batcher.transform(backgroundRect);
+    utils::setRendererDrawColor(globals::renderer, level::data.backgroundColor);
+    SDL_RenderFillRect(globals::renderer, &backgroundRect);
+}
+
+/**
+ * @brief Render the static portions of a level that intersect `rect`.
+ * @note Only the cells in `rect` are visited, so the cost of a frame does not depend on the level size.
+*/
+void IngameMapHandler::renderLevelTilelayers(SDL_Rect const& rect) const {
+    if (mTileSpriteOffsets.empty()) return;
+
+    int x0 = std::max(0, rect.x / level::data.tileDestSize.x), x1 = std::min(level::data.tileDestCount.x, (rect.x + rect.w + level::data.tileDestSize.x - 1) / level::data.tileDestSize.x);
+    int y0 = std::max(0, rect.y / level::data.tileDestSize.y), y1 = std::min(level::data.tileDestCount.y, (rect.y + rect.h + level::data.tileDestSize.y - 1) / level::data.tileDestSize.y);
+
+    SDL_Rect GID_DestRect = { 0, 0, level::data.tileDestSize.x, level::data.tileDestSize.y };
+
+    for (int y = y0; y < y1; ++y) {
+        GID_DestRect.y = y * GID_DestRect.h;
+
+        for (int x = x0; x < x1; ++x) {
+            GID_DestRect.x = x * GID_DestRect.w;
+            auto i = y * level::data.tileDestCount.x + x;
+
+            for (auto j = mTileSpriteOffsets[i]; j < mTileSpriteOffsets[i + 1]; ++j) {
+                auto const& sprite = mTileSprites[j];
+                auto texture = sprite.texture;
+
+                if (isOnGrayscale) {
+                    auto it = mGrayscaleTilesets.find(texture);
+                    if (it != mGrayscaleTilesets.end() && it->second != nullptr) texture = it->second;
+                }
+
+                globals::batcher.draw(texture, sprite.srcRect, GID_DestRect, SDL_FLIP_NONE, 0, nullptr, { 0xff, 0xff, 0xff, 0xff }, sprite.layer);   // Tiles of one tilelayer never overlap, hence may be reordered by tileset
+            }
+        }
+    }
+}
@@ -8,38 +8,68 @@
 #include <auxiliaries.hpp>
 
 
-IngameViewHandler::IngameViewHandler(std::function<void()> const& callable, SDL_Rect& targetedEntityDestRect) : AbstractInterface<IngameViewHandler>(), kRenderMethod(callable), mTargetedEntityDestRect(targetedEntityDestRect) {}
+IngameViewHandler::IngameViewHandler(std::function<CullingStats(SDL_Rect const&)> const& callable, SDL_Rect& targetedEntityDestRect) : AbstractInterface<IngameViewHandler>(), kRenderMethod(callable), mTargetedEntityDestRect(targetedEntityDestRect) {}
 
+/**
+ * @brief Render dependencies straight to the current render target through a camera transform on `globals::batcher`.
+ * @note Only the visible portion of the level is touched i.e. no level-sized intermediate texture is involved.
+*/
 void IngameViewHandler::render() const {
-    // Focus on player entity
-    // auto cachedRenderTarget = SDL_GetRenderTarget(globals::renderer);
-    SDL_Texture* cachedRenderTarget = nullptr;
-    SDL_SetRenderTarget(globals::renderer, mTexture);
-
-    // Render dependencies
-    std::invoke(kRenderMethod);
+    SDL_FPoint offset, scale;
+    SDL_Rect clipRect;
 
     switch (mView) {
         case View::kFullScreen:
-            SDL_SetRenderTarget(globals::renderer, cachedRenderTarget);
-            SDL_RenderCopy(globals::renderer, mTexture, nullptr, &mDestRect);
+            scale = { static_cast<float>(mDestRect.w) / mTextureSize.x, static_cast<float>(mDestRect.h) / mTextureSize.y };
+            offset = { static_cast<float>(mDestRect.x), static_cast<float>(mDestRect.y) };
+            clipRect = mDestRect;
             break;
 
         case View::kTargetEntity:
-            // Calculate rendered portion
-            mViewport.x = mTargetedEntityDestRect.x + (mTargetedEntityDestRect.w - mViewport.w) / 2;
-            mViewport.y = mTargetedEntityDestRect.y + (mTargetedEntityDestRect.h - mViewport.h) / 2;
-
-            // "Fix" out-of-bound cases
-            if (mViewport.x < 0) mViewport.x = 0;
-            else if (mViewport.x + mViewport.w > mTextureSize.x) mViewport.x = mTextureSize.x - mViewport.w;
-            if (mViewport.y < 0) mViewport.y = 0;
-            else if (mViewport.y + mViewport.h > mTextureSize.y) mViewport.y = mTextureSize.y - mViewport.h;
-
-            SDL_SetRenderTarget(globals::renderer, cachedRenderTarget);
-            SDL_RenderCopy(globals::renderer, mTexture, &mViewport, nullptr);
+            mViewport = getVisibleRect();
+            scale = { static_cast<float>(globals::windowSize.x) / mViewport.w, static_cast<float>(globals::windowSize.y) / mViewport.h };
+            offset = { -mViewport.x * scale.x, -mViewport.y * scale.y };
+            clipRect = { 0, 0, globals::windowSize.x, globals::windowSize.y };
             break;
     }
+
+    globals::batcher.setTransform(offset, scale);
+    SDL_RenderSetClipRect(globals::renderer, &clipRect);   // Entities straddling the level boundary must not spill over
+
+    // Render dependencies, skipping those out of view
+    mCullingStats = std::invoke(kRenderMethod, getCullingRect());
+
+    SDL_RenderSetClipRect(globals::renderer, nullptr);
+    globals::batcher.resetTransform();
+}
+
+/**
+ * @brief Retrieve the portion of the level, in pixels, that is shown on the window.
+*/
+SDL_Rect IngameViewHandler::getVisibleRect() const {
+    if (mView == View::kFullScreen) return { 0, 0, mTextureSize.x, mTextureSize.y };
+
+    // Calculate rendered portion
+    auto viewport = mViewport;
+    viewport.x = mTargetedEntityDestRect.x + (mTargetedEntityDestRect.w - viewport.w) / 2;
+    viewport.y = mTargetedEntityDestRect.y + (mTargetedEntityDestRect.h - viewport.h) / 2;
+
+    // "Fix" out-of-bound cases
+    if (viewport.x < 0) viewport.x = 0;
+    else if (viewport.x + viewport.w > mTextureSize.x) viewport.x = mTextureSize.x - viewport.w;
+    if (viewport.y < 0) viewport.y = 0;
+    else if (viewport.y + viewport.h > mTextureSize.y) viewport.y = mTextureSize.y - viewport.h;
+
+    return viewport;
+}
+
+/**
+ * @brief Retrieve `getVisibleRect()` widened by `config::entities::CullingMargin` tiles, so that entities partially in view, or about to be, are kept.
+*/
+SDL_Rect IngameViewHandler::getCullingRect() const {
+    auto rect = getVisibleRect();
+    SDL_Point margin = { config::entities::CullingMargin * level::data.tileDestSize.x, config::entities::CullingMargin * level::data.tileDestSize.y };
+    return { rect.x - margin.x, rect.y - margin.y, rect.w + (margin.x << 1), rect.h + (margin.y << 1) };
 }
 
 void IngameViewHandler::onWindowChange() {
@@ -69,13 +99,11 @@ void IngameViewHandler::onWindowChange() {
 }
 
 void IngameViewHandler::onLevelChange() {
-    if (mTexture != nullptr) SDL_DestroyTexture(mTexture);
     mTextureSize = {
         level::data.tileDestCount.x * level::data.tileDestSize.x,
         level::data.tileDestCount.y * level::data.tileDestSize.y,
-    };
-    mTexture = SDL_CreateTexture(globals::renderer, SDL_PixelFormatEnum::SDL_PIXELFORMAT_RGBA32, SDL_TextureAccess::SDL_TEXTUREACCESS_TARGET, mTextureSize.x, mTextureSize.y);
-    
+    };   // Not backed by `mTexture`, dependencies are rendered in camera space
+
     mTileCountHeight = level::data.viewportHeight;
     onWindowChange();
 
@@ -35,9 +35,11 @@ void MenuInterface::deinitialize() {
     Singleton<MenuInterface>::deinitialize();
 }
 
+/**
+ * @note Components are rendered by `UICompositor` on top.
+*/
 void MenuInterface::render() const {
     renderBackground();
-    renderComponents();
 }
 
 /**
@@ -46,10 +48,10 @@ void MenuInterface::render() const {
 void MenuInterface::renderBackground() const {
     utils::setRendererDrawColor(globals::renderer, config::color::darker);
     SDL_RenderFillRect(globals::renderer, nullptr);
+    MenuParallax::invoke(&MenuParallax::render);   // Animated, hence not retained
 }
 
 void MenuInterface::renderComponents() const {
-    MenuParallax::invoke(&MenuParallax::render);
     // MenuAvatar::invoke(&MenuAvatar::render);
     MenuButton::invoke(&MenuButton::render);
     MenuTitle::invoke(&MenuTitle::render);
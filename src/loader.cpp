@@ -0,0 +1,151 @@
+#include <loader.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+#include <SDL.h>
+
+#include <auxiliaries.hpp>
+
+
+AssetLoader::AssetLoader(std::size_t workerCount) : mBaseCounter(SDL_GetPerformanceCounter()) {
+    for (std::size_t i = 0; i < std::max<std::size_t>(workerCount, 1); ++i) mWorkers.emplace_back(&AssetLoader::work, this);
+}
+
+/**
+ * @note Tasks not yet finalized are dropped, after the decodes in progress have returned.
+*/
+AssetLoader::~AssetLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsStopping = true;
+    }
+    mPendingCondition.notify_all();
+
+    for (auto& worker : mWorkers) if (worker.joinable()) worker.join();
+}
+
+AssetLoader::TaskID AssetLoader::submit(Task const& task) {
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto id = mEntries.size();
+    mEntries.push_back({ task, task.decode ? Status::kPending : Status::kDecoded });
+    if (task.decode) {
+        mPending.push_back(id);
+        mPendingCondition.notify_one();
+    }
+
+    return id;
+}
+
+/**
+ * @brief Block until the task `id` is finalized, finalizing it on the spot.
+ * @note Other tasks are left as is, however long they have been decoded.
+*/
+void AssetLoader::wait(TaskID id) {
+    if (id >= mEntries.size()) return;
+
+    auto& entry = mEntries[id];
+    if (getStatus(entry) == Status::kFinalized) return;
+
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mDecodedCondition.wait(lock, [&]() { return entry.status != Status::kPending; });
+    }
+
+    finalizeEntry(entry);
+}
+
+void AssetLoader::waitAll() {
+    for (auto id = mFirstUnfinalized; id < mEntries.size(); ++id) wait(id);
+}
+
+/**
+ * @brief Finalize tasks that are ready, in submission order, for up to `budgetMilliseconds`. Never blocks on a worker.
+ * @note Meant to be called once per frame, so that assets still pending are finalized without stalling.
+*/
+void AssetLoader::finalize(double budgetMilliseconds) {
+    auto deadline = now() + budgetMilliseconds;
+
+    for (auto id = mFirstUnfinalized; id < mEntries.size() && now() < deadline; ++id) {
+        auto& entry = mEntries[id];
+        if (isFinalizable(entry)) finalizeEntry(entry);
+    }
+}
+
+/**
+ * @brief Record that startup has reached `name`, e.g. to compare the time to first frame with and without this loader.
+*/
+void AssetLoader::markPhase(std::string const& name) {
+    mPhases.push_back({ name, now() });
+}
+
+AssetLoader::Stats AssetLoader::getStats() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return { mEntries.size(), mDecodeMilliseconds, mFinalizeMilliseconds };
+}
+
+void AssetLoader::work() {
+    while (true) {
+        Entry* entry;
+
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mPendingCondition.wait(lock, [&]() { return mIsStopping || !mPending.empty(); });
+            if (mIsStopping) return;
+
+            entry = &mEntries[mPending.front()];
+            mPending.pop_front();
+        }
+
+        auto begin = now();
+        entry->task.decode();
+        auto elapsed = now() - begin;
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            entry->status = Status::kDecoded;
+            mDecodeMilliseconds += elapsed;
+        }
+        mDecodedCondition.notify_all();
+    }
+}
+
+AssetLoader::Status AssetLoader::getStatus(Entry const& entry) const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return entry.status;
+}
+
+bool AssetLoader::isFinalizable(Entry const& entry) const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return entry.status == Status::kDecoded;
+}
+
+/**
+ * @note Requires `entry` to be decoded.
+*/
+void AssetLoader::finalizeEntry(Entry& entry) {
+    auto begin = now();
+    if (entry.task.finalize) entry.task.finalize();
+    entry.task = {};   // Release whatever the task captured e.g. decoded surfaces
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        entry.status = Status::kFinalized;
+        mFinalizeMilliseconds += now() - begin;
+        while (mFirstUnfinalized < mEntries.size() && mEntries[mFirstUnfinalized].status == Status::kFinalized) ++mFirstUnfinalized;
+        if (mFirstUnfinalized < mEntries.size() || mIsReported) return;
+    }
+
+    mIsReported = true;
+    markPhase("assets");
+    if constexpr(!config::enable_startup_report) return;
+    for (auto const& phase : mPhases) SDL_Log("%s: %.1f ms", phase.name.c_str(), phase.milliseconds);
+    auto stats = getStats();
+    SDL_Log("%zu tasks: %.1f ms decoding across %zu workers, %.1f ms finalizing", stats.taskCount, stats.decodeMilliseconds, mWorkers.size(), stats.finalizeMilliseconds);
+}
+
+double AssetLoader::now() const {
+    return static_cast<double>(SDL_GetPerformanceCounter() - mBaseCounter) * 1000 / SDL_GetPerformanceFrequency();
+}
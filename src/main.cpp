@@ -1,3 +1,5 @@
+#include <string>
+
 #include <game.hpp>
 #include <auxiliaries.hpp>
 
@@ -39,6 +41,12 @@
 
 
 int main(int argc, char* args[]) {
+    if (argc > 1 && std::string(args[1]) == "--pack") return AssetArchive::pack(config::path::asset, config::path::archive) ? 0 : 1;
+    if (argc > 1 && std::string(args[1]) == "--benchmark") {
+        pathfinders::benchmark();
+        return 0;
+    }
+
     auto game = Game::instantiate(config::game::initializer);
     game->start();
 
@@ -1,8 +1,14 @@
 #include <mixer.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <unordered_set>
+
 #include <SDL_mixer.h>
 
 #include <meta.hpp>
+#include <timers.hpp>
 #include <auxiliaries.hpp>
 
 
@@ -10,20 +16,20 @@ Mixer::Mixer() : Singleton<Mixer>() {
     setMasterVolume(config::mixer::masterVolume);
     setBGMVolume(config::mixer::BGM_Volume);
 
-    for (auto& pair : kGameStateBGMMapping) if (pair.second.first == nullptr) pair.second.first = Mix_LoadMUS(pair.second.second.string().c_str());
-    for (auto& pair : kLevelBGMMapping) if (pair.second.first == nullptr) pair.second.first = Mix_LoadMUS(pair.second.second.string().c_str());
+    Mix_AllocateChannels(config::mixer::SFXVoiceCount);
+    mVoices.resize(config::mixer::SFXVoiceCount);
+    setSFXVolume(config::mixer::SFX_Volume);   // `Mix_Volume()` only affects channels allocated so far
 
-    #if !defined(__linux__)
-    setSFXVolume(config::mixer::SFX_Volume);
+    // `Mix_LoadWAV()` decodes the whole file to PCM in the output format, so that playing costs mixing only
+    for (auto& pair : kSFXMapping) if (pair.second.chunk == nullptr) pair.second.chunk = Mix_LoadWAV_RW(globals::archive.open(pair.second.path), 1);
 
-    for (auto& pair : kSFXMapping) if (pair.second.first == nullptr) pair.second.first = Mix_LoadWAV(pair.second.second.string().c_str());
-    #endif
+    if constexpr(config::enable_startup_report) reportDeferredBGM();
 }
 
 Mixer::~Mixer() {
-    for (auto& pair : kGameStateBGMMapping) if (pair.second.first != nullptr) Mix_FreeMusic(pair.second.first);
-    for (auto& pair : kLevelBGMMapping) if (pair.second.first != nullptr) Mix_FreeMusic(pair.second.first);
-    for (auto& pair : kSFXMapping) if (pair.second.first != nullptr) Mix_FreeChunk(pair.second.first);
+    for (auto& pair : mTracks) if (pair.second.music != nullptr) Mix_FreeMusic(pair.second.music);   // Pending reads are waited for by `std::future`
+    Mix_HaltChannel(-1);   // Chunks must not be freed while being played
+    for (auto& pair : kSFXMapping) if (pair.second.chunk != nullptr) Mix_FreeChunk(pair.second.chunk);
 }
 
 int Mixer::getMasterVolume() const {
@@ -39,11 +45,7 @@ int Mixer::getBGMVolume() const {
 }
 
 int Mixer::getSFXVolume() const {
-    #if !defined(__linux__)
     return Mix_Volume(-1, -1);
-    #else
-    return -1;
-    #endif
 }
 
 void Mixer::setMasterVolume(int volume) const {
@@ -59,15 +61,18 @@ void Mixer::setBGMVolume(int volume) const {
 }
 
 void Mixer::setSFXVolume(int volume) const {
-    #if !defined(__linux__)
     if (volume < 0 || volume > MIX_MAX_VOLUME) return;
     Mix_Volume(-1, volume);
-    #endif
 }
 
-void Mixer::playBGM(Mix_Music* BGM) const {
+void Mixer::playBGM(std::filesystem::path const& path) {
     if constexpr(!config::enable_audio) return;
     if (Mix_PlayingMusic()) return;
+
+    auto BGM = getBGM(path);
+    if (BGM == nullptr) return;
+
+    mCurrBGMPath = path.generic_string();
     Mix_PlayMusic(BGM, -1);
 }
 
@@ -88,31 +93,48 @@ void Mixer::unpauseBGM() const {
     Mix_ResumeMusic();
 }
 
-void Mixer::playSFX(SFXName SFX) const {
-    if constexpr(!config::enable_audio) return;
+/**
+ * @brief Play `SFX` at full volume e.g. for effects emitted by the player or the UI.
+*/
+void Mixer::playSFX(SFXName SFX) {
+    emitSFX(SFX, 0);
+}
 
-    #if !defined(__linux__)
-    auto it = kSFXMapping.find(SFX);
-    if (it != kSFXMapping.end()) Mix_PlayChannel(-1, it->second.first, 0);
-    #endif
+/**
+ * @brief Play `SFX` attenuated by the distance between `sourceCoords` and the listener, or not at all beyond `config::mixer::SFXAudibleDistance`.
+*/
+void Mixer::playSFXAt(SFXName SFX, SDL_Point const& sourceCoords) {
+    auto distance = std::hypot(sourceCoords.x - mListenerCoords.x, sourceCoords.y - mListenerCoords.y);
+    if (distance > config::mixer::SFXAudibleDistance) return;
+    emitSFX(SFX, distance);
 }
 
 void Mixer::stopSFX() const {
     if constexpr(!config::enable_audio) return;
-
-    #if !defined(__linux__)
     Mix_HaltChannel(-1);
-    #endif
 }
 
 /**
- * @brief Change BGM upon entering new level.
- * @note Manually called.
+ * @brief Change BGM upon entering new level, then prefetch the BGM of every level reachable via a teleporter.
+ * @note Manually called, after `level::data` has been populated.
 */
-void Mixer::onLevelChange(level::Name newLevel) const {
+void Mixer::onLevelChange(level::Name newLevel) {
     stopBGM();
     auto it = kLevelBGMMapping.find(newLevel);
-    if (it != kLevelBGMMapping.end()) playBGM(it->second.first);
+    if (it != kLevelBGMMapping.end()) playBGM(it->second);
+
+    for (auto const& pair : level::data.dependencies) for (auto data : pair.second) {
+        auto teleporterData = dynamic_cast<level::Data_Teleporter*>(data);
+        if (teleporterData == nullptr) continue;
+
+        auto targetIt = kLevelBGMMapping.find(teleporterData->targetLevel);
+        if (targetIt != kLevelBGMMapping.end()) prefetchBGM(targetIt->second);
+    }
+
+    if constexpr(config::enable_startup_report) {
+        auto stats = getStats();
+        SDL_Log("BGM: %zu tracks resident or being prefetched, %zu bytes", stats.residentBGMCount, stats.residentBGMBytes);
+    }
 }
 
 /**
@@ -159,5 +181,166 @@ void Mixer::onGameStateChange(GameState const prev, GameState const next) {
 
     stopBGM();
     auto it = kGameStateBGMMapping.find(next);
-    if (it != kGameStateBGMMapping.end()) playBGM(it->second.first);
+    if (it != kGameStateBGMMapping.end()) playBGM(it->second);
+}
+
+/**
+ * @brief Play `SFX` on a voice, unless it is rate-limited or every voice is taken by a more important effect.
+*/
+void Mixer::emitSFX(SFXName SFX, double distance) {
+    if constexpr(!config::enable_audio) return;
+
+    auto it = kSFXMapping.find(SFX);
+    if (it == kSFXMapping.end() || it->second.chunk == nullptr) return;
+    auto& data = it->second;
+
+    auto currTicks = FrameClock::getTicks();
+    if (data.lastPlayedTicks.has_value() && currTicks - data.lastPlayedTicks.value() < data.rateLimitTicks) return;
+
+    auto channel = allocateVoice(data.priority, distance);
+    if (channel < 0) return;
+
+    Mix_HaltChannel(channel);   // No-op unless stolen
+    Mix_SetDistance(channel, static_cast<Uint8>(std::min(distance / config::mixer::SFXAudibleDistance, 1.0) * 255));   // Zero unregisters the effect altogether
+    if (Mix_PlayChannel(channel, data.chunk, 0) < 0) return;
+
+    mVoices[channel] = { data.priority, distance, currTicks };
+    data.lastPlayedTicks = currTicks;
+}
+
+/**
+ * @brief Select a channel for an effect of `priority` at `distance`: an idle one if any, otherwise the least important busy one, provided it is no more important than the effect.
+ * @return `-1` if the effect should be dropped.
+*/
+int Mixer::allocateVoice(unsigned char priority, double distance) const {
+    int victim = -1;
+
+    for (int channel = 0; channel < static_cast<int>(mVoices.size()); ++channel) {
+        if (!Mix_Playing(channel)) return channel;
+
+        if (victim < 0) { victim = channel; continue; }
+        auto const& voice = mVoices[channel];
+        auto const& victimVoice = mVoices[victim];
+        if (voice.priority != victimVoice.priority ? voice.priority < victimVoice.priority : voice.distance != victimVoice.distance ? voice.distance > victimVoice.distance : voice.startTicks < victimVoice.startTicks) victim = channel;
+    }
+
+    if (victim < 0) return -1;
+    auto const& victimVoice = mVoices[victim];
+    return victimVoice.priority < priority || (victimVoice.priority == priority && victimVoice.distance >= distance) ? victim : -1;
+}
+
+Mixer::Stats Mixer::getStats() const {
+    Stats stats;
+    for (auto const& pair : mTracks) {
+        stats.residentBGMBytes += pair.second.size;
+        ++stats.residentBGMCount;
+    }
+    return stats;
+}
+
+/**
+ * @brief Retrieve the BGM at `path`, reading it synchronously unless already resident, being prefetched, or stored uncompressed within the archive.
+ * @return `nullptr` if the track could not be read or decoded, which is remembered until the track is evicted.
+*/
+Mix_Music* Mixer::getBGM(std::filesystem::path const& path) {
+    auto key = path.generic_string();
+    auto it = mTracks.find(key);
+    bool isMapped = false;
+
+    if (it == mTracks.end()) {
+        it = mTracks.emplace(key, Track{}).first;
+        isMapped = globals::archive.isMapped(path);
+        if (!isMapped) it->second.data = readBGM(path);
+    } else if (it->second.pendingData.valid()) {
+        it->second.data = it->second.pendingData.get();   // Blocks only if the read has yet to finish
+    } else {
+        it->second.lastUsed = ++mUseCount;
+        return it->second.music;
+    }
+
+    auto& track = it->second;
+    track.lastUsed = ++mUseCount;
+    track.size = track.data.size();
+    if (isMapped) track.music = Mix_LoadMUS_RW(globals::archive.open(path), 1);   // Streams from the mapping in place
+    else if (!track.data.empty()) track.music = Mix_LoadMUS_RW(SDL_RWFromConstMem(track.data.data(), static_cast<int>(track.data.size())), 1);   // `data` outlives `music`
+
+    evictBGM(key);
+    return track.music;
+}
+
+/**
+ * @brief Start reading the BGM at `path` in the background, so that a subsequent `getBGM()` does not touch the disk.
+ * @note Tracks larger than the budget are left to be read upon use. Tracks stored uncompressed within the archive are never copied, hence not prefetched.
+*/
+void Mixer::prefetchBGM(std::filesystem::path const& path) {
+    if constexpr(!config::enable_audio) return;
+
+    auto key = path.generic_string();
+    if (mTracks.find(key) != mTracks.end() || globals::archive.isMapped(path)) return;
+
+    auto size = globals::archive.getSize(path);   // The file might only exist within the archive
+    if (!size.has_value() || size.value() > config::mixer::BGMCacheBudget) return;
+
+    auto& track = mTracks.emplace(key, Track{}).first->second;
+    track.pendingData = std::async(std::launch::async, readBGM, path);
+    track.size = size.value();
+    track.lastUsed = ++mUseCount;
+
+    evictBGM(key);
+}
+
+/**
+ * @brief Free the least recently used tracks until the resident ones fit within `config::mixer::BGMCacheBudget`.
+ * @param exemptKey the track just retrieved or prefetched, which must outlive this call.
+ * @note Neither the current BGM, `exemptKey` nor tracks still being read are evicted, hence the budget might be temporarily exceeded.
+*/
+void Mixer::evictBGM(std::string const& exemptKey) {
+    auto residentBytes = getStats().residentBGMBytes;
+
+    while (residentBytes > config::mixer::BGMCacheBudget) {
+        auto victim = mTracks.end();
+        for (auto it = mTracks.begin(); it != mTracks.end(); ++it) {
+            if (it->first == mCurrBGMPath || it->first == exemptKey) continue;
+            if (it->second.pendingData.valid() && it->second.pendingData.wait_for(std::chrono::seconds(0)) != std::future_status::ready) continue;   // Destroying the future would block until the read finishes
+            if (victim == mTracks.end() || it->second.lastUsed < victim->second.lastUsed) victim = it;
+        }
+        if (victim == mTracks.end()) return;
+
+        residentBytes -= victim->second.size;
+        if (victim->second.music != nullptr) Mix_FreeMusic(victim->second.music);
+        mTracks.erase(victim);
+    }
+}
+
+/**
+ * @brief Log how many BGM tracks and bytes are no longer loaded upon construction, and how long loading them would take.
+ * @note The time is measured by loading then freeing every track as construction formerly did, hence this report itself costs that time.
+*/
+void Mixer::reportDeferredBGM() const {
+    std::unordered_set<std::string> keys;
+    std::size_t deferredBytes = 0;
+    auto begin = SDL_GetPerformanceCounter();
+
+    auto defer = [&](std::filesystem::path const& path) {
+        if (!keys.insert(path.generic_string()).second) return;
+        deferredBytes += globals::archive.getSize(path).value_or(0);
+
+        auto music = Mix_LoadMUS_RW(globals::archive.open(path), 1);
+        if (music != nullptr) Mix_FreeMusic(music);
+    };
+    for (auto const& pair : kGameStateBGMMapping) defer(pair.second);
+    for (auto const& pair : kLevelBGMMapping) defer(pair.second);
+
+    auto milliseconds = static_cast<double>(SDL_GetPerformanceCounter() - begin) * 1000 / SDL_GetPerformanceFrequency();
+    SDL_Log("BGM: %zu tracks, %zu bytes deferred past startup, saving %.1f ms", keys.size(), deferredBytes, milliseconds);
+}
+
+/**
+ * @brief Read the encoded track at `path` into memory.
+ * @note Safe to call from any thread.
+*/
+std::vector<char> Mixer::readBGM(std::filesystem::path const& path) {
+    std::vector<char> data;
+    if (!globals::archive.read(path, data)) return {};
+    return data;
 }
\ No newline at end of file
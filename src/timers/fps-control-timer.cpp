@@ -1,9 +1,75 @@
 #include <timers.hpp>
 
-#include <SDL_timer.h>
+#include <algorithm>
+#include <numeric>
+#include <thread>
 
+#include <SDL.h>
 
+
+FPSControlTimer::FPSControlTimer() {
+    SDL_RendererInfo rendererInfo;
+    SDL_DisplayMode displayMode;
+
+    if (config::game::isVSyncAware && globals::renderer != nullptr && !SDL_GetRendererInfo(globals::renderer, &rendererInfo)) mIsVSyncPaced = rendererInfo.flags & SDL_RENDERER_PRESENTVSYNC;
+    if (mIsVSyncPaced && !SDL_GetCurrentDisplayMode(0, &displayMode) && displayMode.refresh_rate > 0) mRefreshMilliseconds = 1000.0 / displayMode.refresh_rate;   // Unknown refresh rates are reported as 0
+
+    mPrevFrameEnd = FrameClock::now();
+    mDeadline = mPrevFrameEnd + kMillisecondsPerFrame;
+}
+
+/**
+ * @brief Hold the frame until its deadline. Called once at the end of every frame.
+ * @note Measured in real time, since `getTicks()` follows the simulation.
+*/
 void FPSControlTimer::controlFPS() {
-    auto ticks = getTicks();
-    if (ticks < kTicksPerFrame) SDL_Delay(kTicksPerFrame - ticks);
-}
\ No newline at end of file
+    auto currMilliseconds = FrameClock::now();
+
+    if (mIsVSyncPaced) {
+        if (currMilliseconds - mPrevFrameEnd > mRefreshMilliseconds * 1.5) ++mMissedDeadlineCount;   // At least one refresh was skipped
+    } else if (currMilliseconds > mDeadline) {
+        ++mMissedDeadlineCount;
+        mDeadline = currMilliseconds;   // Resynchronize instead of rushing the following frames to catch up
+    } else wait(mDeadline);
+
+    mDeadline += kMillisecondsPerFrame;
+
+    currMilliseconds = FrameClock::now();
+    record(currMilliseconds - mPrevFrameEnd);
+    mPrevFrameEnd = currMilliseconds;
+}
+
+double FPSControlTimer::getAverageFrameMilliseconds() const {
+    return mFrameHistoryCount ? std::accumulate(mFrameHistory.begin(), mFrameHistory.begin() + mFrameHistoryCount, 0.0) / mFrameHistoryCount : 0;
+}
+
+double FPSControlTimer::getMaxFrameMilliseconds() const {
+    return mFrameHistoryCount ? *std::max_element(mFrameHistory.begin(), mFrameHistory.begin() + mFrameHistoryCount) : 0;
+}
+
+/**
+ * @brief Sleep for the bulk of the remaining time, then spin for the last `mSpinMilliseconds`.
+ * @note The spin margin tracks how much `SDL_Delay()` oversleeps, bounding busy-waiting to roughly the scheduler granularity.
+*/
+void FPSControlTimer::wait(double deadline) {
+    auto remainingMilliseconds = deadline - FrameClock::now();
+
+    if (remainingMilliseconds > mSpinMilliseconds) {
+        auto requestedMilliseconds = static_cast<Uint32>(remainingMilliseconds - mSpinMilliseconds);
+        if (requestedMilliseconds) {
+            auto sleepStart = FrameClock::now();
+            SDL_Delay(requestedMilliseconds);
+            auto oversleptMilliseconds = FrameClock::now() - sleepStart - requestedMilliseconds;
+
+            mSpinMilliseconds = std::clamp(mSpinMilliseconds * 0.875 + (oversleptMilliseconds + kMinSpinMilliseconds) * 0.125, kMinSpinMilliseconds, kMaxSpinMilliseconds);   // Exponential moving average, with headroom
+        }
+    }
+
+    while (FrameClock::now() < deadline) std::this_thread::yield();
+}
+
+void FPSControlTimer::record(double frameMilliseconds) {
+    mFrameHistory[mFrameHistoryIndex] = frameMilliseconds;
+    mFrameHistoryIndex = (mFrameHistoryIndex + 1) % mFrameHistory.size();
+    mFrameHistoryCount = std::min(mFrameHistoryCount + 1, mFrameHistory.size());
+}
@@ -3,8 +3,11 @@
 #include <SDL_timer.h>
 
 
+/**
+ * @note Measured in real time, since `getTicks()` follows the simulation.
+*/
 void FPSDisplayTimer::calculateFPS() {
-    mAverageFPS = mAccumulatedFrames / (getTicks() / 1000.0f);
+    mAverageFPS = mAccumulatedFrames / (FrameClock::getMilliseconds() / 1000.0f);
     if (mAccumulatedFrames >= std::numeric_limits<unsigned long long int>::max()) mAccumulatedFrames = 0;
     ++mAccumulatedFrames;
 }
\ No newline at end of file
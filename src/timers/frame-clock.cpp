@@ -0,0 +1,51 @@
+#include <timers.hpp>
+
+#include <algorithm>
+
+#include <SDL_timer.h>
+
+
+Uint64 FrameClock::sBaseCounter = 0;
+double FrameClock::sMillisecondsPerCount = 0;
+
+double FrameClock::sFrameMilliseconds = 0;
+double FrameClock::sDeltaMilliseconds = 0;
+
+double FrameClock::sAccumulatedMilliseconds = 0;
+unsigned long long int FrameClock::sTickCount = 0;
+
+/**
+ * @brief Sample the clock for the current frame. Call this exactly once per frame, before anything reads a timer.
+*/
+void FrameClock::tick() {
+    auto frameMilliseconds = now();
+    sDeltaMilliseconds = frameMilliseconds - sFrameMilliseconds;
+    sFrameMilliseconds = frameMilliseconds;
+
+    sAccumulatedMilliseconds = std::min(sAccumulatedMilliseconds + sDeltaMilliseconds, config::game::maxTicksPerFrame * kMillisecondsPerTick);   // Drop the backlog beyond the catch-up limit e.g. after a stall
+}
+
+/**
+ * @brief Consume one simulation tick from the time accumulated by `tick()`.
+ * @return Whether a tick is due, in which case the simulation time has been advanced by exactly one tick.
+ * @note Intended as the condition of a loop i.e. `while (FrameClock::step()) ...`.
+*/
+bool FrameClock::step() {
+    if (sAccumulatedMilliseconds < kMillisecondsPerTick) return false;
+
+    sAccumulatedMilliseconds -= kMillisecondsPerTick;
+    ++sTickCount;
+    return true;
+}
+
+/**
+ * @brief Retrieve the live time elapsed since the first sample, in milliseconds.
+ * @note Unlike `getMilliseconds()`, this is not frozen within a frame. Reserved for measuring the frame itself e.g. frame-rate capping.
+*/
+double FrameClock::now() {
+    if (!sBaseCounter) {
+        sBaseCounter = SDL_GetPerformanceCounter();
+        sMillisecondsPerCount = 1000.0 / SDL_GetPerformanceFrequency();
+    }
+    return (SDL_GetPerformanceCounter() - sBaseCounter) * sMillisecondsPerCount;
+}
@@ -1,7 +1,5 @@
 #include <timers.hpp>
 
-#include <SDL_timer.h>
-
 
 /**
  * @note This method can also be used to restart the timer.
@@ -10,7 +8,7 @@ void GenericTimer::start() {
     mIsStarted = true;
     mIsPaused = false;
 
-    mStartTicks = SDL_GetTicks();
+    mStartTicks = FrameClock::getTicks();
     mPausedTicks = 0;
 }
 
@@ -26,7 +24,7 @@ void GenericTimer::pause() {
     if (!mIsStarted || mIsPaused) return;
 
     mIsPaused = true;
-    mPausedTicks = SDL_GetTicks() - mStartTicks;   // The time the timer was paused based on `startTicks`
+    mPausedTicks = FrameClock::getTicks() - mStartTicks;   // The time the timer was paused based on `startTicks`
     mStartTicks = 0;
 }
 
@@ -34,10 +32,10 @@ void GenericTimer::unpause() {
     if (!mIsStarted || !mIsPaused) return;
 
     mIsPaused = false;
-    mStartTicks = SDL_GetTicks() - mPausedTicks;   // Continue based on previously recorded `pausedTicks`
+    mStartTicks = FrameClock::getTicks() - mPausedTicks;   // Continue based on previously recorded `pausedTicks`
     mPausedTicks = 0;
 }
 
 unsigned int GenericTimer::getTicks() const {
-    return mIsStarted ? (mIsPaused ? mPausedTicks : SDL_GetTicks() - mStartTicks) : 0;
+    return mIsStarted ? (mIsPaused ? mPausedTicks : FrameClock::getTicks() - mStartTicks) : 0;
 }
\ No newline at end of file
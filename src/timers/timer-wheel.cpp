@@ -0,0 +1,94 @@
+#include <timers.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+
+TimerWheel::TimerWheel() : mCurrTicks(FrameClock::getTicks()) {}
+
+/**
+ * @brief Register `callback` to be fired once, `delayTicks` milliseconds after the current frame.
+ * @return A handle that stays valid until the callback is fired or cancelled.
+*/
+TimerWheel::Handle TimerWheel::schedule(unsigned int delayTicks, Callback const& callback) {
+    auto handle = mNextHandle++;
+    mActiveHandles.insert(handle);
+    insert({ handle, FrameClock::getTicks() + delayTicks, callback });
+    return handle;
+}
+
+/**
+ * @note Invalid, fired or already cancelled handles are ignored.
+*/
+void TimerWheel::cancel(Handle handle) {
+    mActiveHandles.erase(handle);
+}
+
+/**
+ * @brief Catch up with `FrameClock` and fire every callback that has become due.
+ * @note The work done is proportional to the elapsed ticks and the number of due timers; pending timers cost nothing.
+*/
+void TimerWheel::advance() {
+    auto currTicks = FrameClock::getTicks();
+
+    mDue.swap(mOverdue);
+
+    if (mActiveHandles.empty()) mCurrTicks = currTicks;   // Nothing to cascade; stale entries of cancelled timers are dropped whenever their slots are reached
+    while (mCurrTicks != currTicks) {
+        ++mCurrTicks;
+
+        // Cascade from the outermost level whose index has just wrapped around
+        int level = 0;
+        while (level + 1 < kLevelCount && !(mCurrTicks >> (kSlotBits * level) & kSlotMask)) ++level;
+        for (; level > 0; --level) cascade(level);
+
+        auto& slot = mSlots[0][mCurrTicks & kSlotMask];
+        std::move(slot.begin(), slot.end(), std::back_inserter(mDue));
+        slot.clear();
+    }
+
+    for (auto& timer : mDue) {
+        if (!mActiveHandles.erase(timer.handle)) continue;   // Cancelled
+        timer.callback();
+    }
+    mDue.clear();
+}
+
+/**
+ * @brief Drop every pending timer without firing it.
+*/
+void TimerWheel::clear() {
+    for (auto& level : mSlots) for (auto& slot : level) slot.clear();
+    mOverdue.clear();
+    mActiveHandles.clear();
+    mCurrTicks = FrameClock::getTicks();
+}
+
+void TimerWheel::insert(Timer&& timer) {
+    auto delta = timer.deadline - mCurrTicks;
+    if (timer.deadline == mCurrTicks || delta > std::numeric_limits<unsigned int>::max() >> 1) {   // Due now or in the past, accounting for wrap-around
+        mOverdue.push_back(std::move(timer));
+        return;
+    }
+
+    int level = 0;
+    while (level + 1 < kLevelCount && delta >> (kSlotBits * (level + 1))) ++level;
+    auto placement = delta > kMaxDelta ? mCurrTicks + kMaxDelta : timer.deadline;   // Too far ahead: park in the outermost level, to be re-cascaded
+    mSlots[level][placement >> (kSlotBits * level) & kSlotMask].push_back(std::move(timer));
+}
+
+/**
+ * @brief Redistribute the timers of the current slot of `level` into the inner levels.
+*/
+void TimerWheel::cascade(int level) {
+    auto& slot = mSlots[level][mCurrTicks >> (kSlotBits * level) & kSlotMask];
+    auto timers = std::move(slot);
+    slot.clear();
+
+    for (auto& timer : timers) {
+        if (mActiveHandles.find(timer.handle) == mActiveHandles.end()) continue;
+        if (timer.deadline == mCurrTicks) mSlots[0][mCurrTicks & kSlotMask].push_back(std::move(timer));   // Due on this very tick, whose slot is drained right after cascading
+        else insert(std::move(timer));
+    }
+}